@@ -0,0 +1,82 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "command_registry.hpp"
+#include "command_table.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static std::size_t total = 0;
+
+static void accumulate(std::span<const std::string_view> arguments, const command_t::output_t& /* output */)
+{
+    total += arguments.size();
+}
+
+static constexpr command_table_t table(std::array{
+    command_t{"cancel", "", &accumulate},
+    command_t{"depth", "", &accumulate},
+    command_t{"histogram", "", &accumulate},
+    command_t{"order", "", &accumulate},
+    command_t{"quit", "", &accumulate},
+    command_t{"replay", "", &accumulate},
+    command_t{"stats", "", &accumulate},
+    command_t{"stop", "", &accumulate},
+});
+
+// A replayed script: short commands with a handful of arguments.
+static constexpr std::array<std::string_view, 4> script = {
+    "order buy 100 XYZ 10.25",
+    "cancel 42",
+    "stats orders fills",
+    "replay /var/log/session.txt 1.5",
+};
+
+static void table_dispatch(benchmark::State& state)
+{
+    const command_t::output_t output = [](std::string_view /* line */) {};
+
+    for (auto _ : state)
+    {
+        for (auto line : script)
+        {
+            benchmark::DoNotOptimize(table.execute(line, output));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(script.size()));
+}
+
+static void registry_dispatch(benchmark::State& state)
+{
+    command_registry_t registry;
+    registry.add(table);
+
+    const command_t::output_t output = [](std::string_view /* line */) {};
+
+    for (auto _ : state)
+    {
+        for (auto line : script)
+        {
+            benchmark::DoNotOptimize(registry.execute(line, output));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(script.size()));
+}
+
+BENCHMARK(table_dispatch);
+BENCHMARK(registry_dispatch);
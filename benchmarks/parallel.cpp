@@ -0,0 +1,199 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "parallel.hpp"
+
+/// \cond
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(TOOLBOX_PARALLEL_STL)
+    #include <execution>
+#endif
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+namespace
+{
+    std::vector<double> make_input(std::size_t size)
+    {
+        std::vector<double> values(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            values[i] = 1.0 + static_cast<double>(i % 1000) / 1000.0;
+        }
+
+        return values;
+    }
+
+    // Enough work per item for the loop to be compute bound rather than
+    // limited by memory bandwidth.
+    double kernel(double value)
+    {
+        return std::sqrt(value) * std::log(value);
+    }
+
+    void set_items(benchmark::State& state)
+    {
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+    }
+}  // namespace
+
+static void transform_serial(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> output(input.size());
+
+    for (auto _ : state)
+    {
+        std::transform(input.begin(), input.end(), output.begin(), kernel);
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    set_items(state);
+}
+
+static void transform_parallel_for(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> output(input.size());
+
+    for (auto _ : state)
+    {
+        parallel_for(0, input.size(), [&](std::size_t i) { output[i] = kernel(input[i]); });
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    set_items(state);
+}
+
+static void reduce_serial(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::accumulate(input.begin(), input.end(), 0.0));
+    }
+
+    set_items(state);
+}
+
+static void reduce_parallel(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parallel_reduce(std::span(input), 0.0, std::plus<>()));
+    }
+
+    set_items(state);
+}
+
+static void reduce_parallel_deterministic(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parallel_reduce(std::span(input), 0.0, std::plus<>(), {.deterministic = true}));
+    }
+
+    set_items(state);
+}
+
+static void scan_serial(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> output(input.size());
+
+    for (auto _ : state)
+    {
+        std::inclusive_scan(input.begin(), input.end(), output.begin());
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    set_items(state);
+}
+
+static void scan_parallel(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> output(input.size());
+
+    for (auto _ : state)
+    {
+        parallel_inclusive_scan(std::span(std::as_const(input)), std::span(output), std::plus<>());
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    set_items(state);
+}
+
+BENCHMARK(transform_serial)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(transform_parallel_for)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->UseRealTime();
+BENCHMARK(reduce_serial)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(reduce_parallel)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->UseRealTime();
+BENCHMARK(reduce_parallel_deterministic)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->UseRealTime();
+BENCHMARK(scan_serial)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(scan_parallel)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->UseRealTime();
+
+#if defined(TOOLBOX_PARALLEL_STL)
+static void transform_std_par(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> output(input.size());
+
+    for (auto _ : state)
+    {
+        std::transform(std::execution::par, input.begin(), input.end(), output.begin(), kernel);
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    set_items(state);
+}
+
+static void reduce_std_par(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::reduce(std::execution::par, input.begin(), input.end(), 0.0));
+    }
+
+    set_items(state);
+}
+
+static void scan_std_par(benchmark::State& state)
+{
+    auto input = make_input(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> output(input.size());
+
+    for (auto _ : state)
+    {
+        std::inclusive_scan(std::execution::par, input.begin(), input.end(), output.begin());
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    set_items(state);
+}
+
+BENCHMARK(transform_std_par)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->UseRealTime();
+BENCHMARK(reduce_std_par)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->UseRealTime();
+BENCHMARK(scan_std_par)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->UseRealTime();
+#endif
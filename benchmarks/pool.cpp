@@ -0,0 +1,68 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "pool.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+namespace
+{
+    // Roughly the size of accepted-connection state: descriptor, addresses,
+    // parser state and a few counters.
+    struct connection_t
+    {
+        int descriptor = -1;
+        std::array<std::byte, 240> state{};
+    };
+
+    // Each iteration opens `live` connections and closes them again, so the
+    // argument sets the connection rate per iteration.
+    template <typename Make>
+    void churn(benchmark::State& state, Make&& make)
+    {
+        auto live = static_cast<std::size_t>(state.range(0));
+
+        using handle_t = decltype(make());
+        std::vector<handle_t> connections;
+        connections.reserve(live);
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < live; ++i)
+            {
+                connections.push_back(make());
+            }
+
+            benchmark::DoNotOptimize(connections.data());
+            connections.clear();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}  // namespace
+
+static void heap_churn(benchmark::State& state)
+{
+    churn(state, [] { return std::make_unique<connection_t>(); });
+}
+
+static void pool_churn(benchmark::State& state)
+{
+    static object_pool_t<connection_t> pool;
+    churn(state, [] { return pool.make(); });
+}
+
+BENCHMARK(heap_churn)->RangeMultiplier(8)->Range(8, 4096)->ThreadRange(1, 4);
+BENCHMARK(pool_churn)->RangeMultiplier(8)->Range(8, 4096)->ThreadRange(1, 4);
@@ -0,0 +1,156 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "scan.hpp"
+
+/// \cond
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+// Log-like input: lines of 40 to 120 bytes with comma separated fields.
+static const std::string& corpus()
+{
+    static const std::string text = [] {
+        std::mt19937 random(7);  // NOLINT(cert-msc51-cpp)
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::uniform_int_distribution<std::size_t> width(40, 120);
+
+        std::string result;
+
+        while (result.size() < 4 * 1024 * 1024)
+        {
+            auto length = width(random);
+
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                result.push_back(i % 12 == 11 ? ',' : static_cast<char>(letter(random)));
+            }
+
+            result.push_back('\n');
+        }
+
+        return result;
+    }();
+
+    return text;
+}
+
+static bool select(benchmark::State& state)
+{
+    if (!scan::force(static_cast<scan::isa_t>(state.range(0))))
+    {
+        state.SkipWithError("instruction set not supported");
+        return false;
+    }
+
+    return true;
+}
+
+static void find_byte(benchmark::State& state)
+{
+    if (!select(state))
+    {
+        return;
+    }
+
+    auto data = scan::bytes(corpus());
+
+    for (auto _ : state)
+    {
+        std::size_t lines = 0;
+
+        for (auto rest = data; !rest.empty(); ++lines)
+        {
+            auto found = scan::find_byte(rest, std::byte{'\n'});
+            rest = found == scan::npos ? rest.last(0) : rest.subspan(found + 1);
+        }
+
+        benchmark::DoNotOptimize(lines);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+}
+
+static void find_any(benchmark::State& state)
+{
+    if (!select(state))
+    {
+        return;
+    }
+
+    auto data = scan::bytes(corpus());
+    auto set = scan::bytes("\n\r\t;");
+
+    for (auto _ : state)
+    {
+        std::size_t matches = 0;
+
+        for (auto rest = data; !rest.empty(); ++matches)
+        {
+            auto found = scan::find_any(rest, set);
+            rest = found == scan::npos ? rest.last(0) : rest.subspan(found + 1);
+        }
+
+        benchmark::DoNotOptimize(matches);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+}
+
+static void count_newlines(benchmark::State& state)
+{
+    if (!select(state))
+    {
+        return;
+    }
+
+    auto data = scan::bytes(corpus());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scan::count_newlines(data));
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+}
+
+static void split(benchmark::State& state)
+{
+    if (!select(state))
+    {
+        return;
+    }
+
+    auto data = scan::bytes(corpus());
+    std::vector<scan::field_t> fields(64);
+
+    for (auto _ : state)
+    {
+        for (auto rest = data; !rest.empty();)
+        {
+            auto found = scan::find_byte(rest, std::byte{'\n'});
+            auto line = found == scan::npos ? rest : rest.first(found);
+
+            benchmark::DoNotOptimize(scan::split(line, std::byte{','}, fields));
+            rest = found == scan::npos ? rest.last(0) : rest.subspan(found + 1);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+}
+
+// Arguments are scan::isa_t values: scalar, sse2, avx2.
+BENCHMARK(find_byte)->DenseRange(0, 2);
+BENCHMARK(find_any)->DenseRange(0, 2);
+BENCHMARK(count_newlines)->DenseRange(0, 2);
+BENCHMARK(split)->DenseRange(0, 2);
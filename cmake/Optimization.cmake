@@ -1,5 +1,8 @@
 option(ENABLE_IPO "Enable Interprocedural Optimizations for project targets" OFF)
 option(OPTIMIZE_FOR_NATIVE "Build for native architecture" OFF)
+option(ENABLE_MULTIVERSIONING "Clone marked kernels for several x86-64 levels, picked at load time" OFF)
+
+set(MULTIVERSION_LEVELS "x86-64-v2;x86-64-v3;x86-64-v4" CACHE STRING "x86-64 levels built when ENABLE_MULTIVERSIONING is ON")
 
 include(CheckIPOSupported)
 
@@ -50,7 +53,30 @@ else()
     endif()
 endif()
 
+# target_clones with arch= levels needs GCC; the resolver runs at load time,
+# so one binary carries every level and the generic one stays the fallback.
+set(PROJECT_TARGET_CLONES "")
+
+if(ENABLE_MULTIVERSIONING)
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64" AND "${CMAKE_CXX_COMPILER_ID}" STREQUAL "GNU")
+        set(PROJECT_TARGET_CLONES "\"default\"")
+
+        foreach(level IN LISTS MULTIVERSION_LEVELS)
+            string(APPEND PROJECT_TARGET_CLONES ",\"arch=${level}\"")
+        endforeach()
+    else()
+        message(STATUS "Multiversioning is not supported for '${CMAKE_CXX_COMPILER_ID}' on '${CMAKE_SYSTEM_PROCESSOR}'")
+    endif()
+endif()
+
 function(setup_target_optimizations target)
+    if(PROJECT_TARGET_CLONES)
+        target_compile_definitions(${target}
+            PRIVATE
+                TOOLBOX_TARGET_CLONES=${PROJECT_TARGET_CLONES}
+        )
+    endif()
+
     if(NOT OPTIMIZE_FOR_NATIVE)
         return()
     endif()
@@ -0,0 +1,140 @@
+set(PGO_MODE "OFF" CACHE STRING "Profile-guided optimization stage for project targets: OFF, GENERATE or USE")
+set_property(CACHE PGO_MODE PROPERTY STRINGS OFF GENERATE USE)
+
+set(PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH "Directory the training run writes profiles to")
+
+option(ENABLE_BOLT "Post-link optimize the PGO training executable with llvm-bolt" OFF)
+
+find_program(LLVM_PROFDATA NAMES llvm-profdata)
+find_program(LLVM_BOLT NAMES llvm-bolt)
+
+# GCC keys its .gcda files by object path; stripping the build directory lets
+# the optimized tree find the profiles the instrumented tree wrote.
+set(GCC_PGO_GENERATE
+    -fprofile-generate=${PGO_PROFILE_DIR}
+    -fprofile-prefix-path=${CMAKE_BINARY_DIR}
+    -fprofile-update=atomic
+)
+
+set(GCC_PGO_USE
+    -fprofile-use=${PGO_PROFILE_DIR}
+    -fprofile-prefix-path=${CMAKE_BINARY_DIR}
+    -fprofile-partial-training
+    -Wno-missing-profile
+)
+
+set(CLANG_PGO_GENERATE
+    -fprofile-generate=${PGO_PROFILE_DIR}
+)
+
+set(CLANG_PGO_USE
+    -fprofile-use=${PGO_PROFILE_DIR}/default.profdata
+    -Wno-profile-instr-unprofiled
+)
+
+if("${CMAKE_CXX_COMPILER_ID}" MATCHES "Clang")
+    set(PROJECT_PGO_GENERATE ${CLANG_PGO_GENERATE})
+    set(PROJECT_PGO_USE ${CLANG_PGO_USE})
+elseif("${CMAKE_CXX_COMPILER_ID}" STREQUAL "GNU")
+    set(PROJECT_PGO_GENERATE ${GCC_PGO_GENERATE})
+    set(PROJECT_PGO_USE ${GCC_PGO_USE})
+elseif(NOT PGO_MODE STREQUAL "OFF")
+    message(STATUS "No profile-guided optimization set for CXX compiler: '${CMAKE_CXX_COMPILER_ID}'")
+endif()
+
+function(setup_target_profile target)
+    if(PGO_MODE STREQUAL "GENERATE")
+        target_compile_options(${target}
+            PRIVATE
+                ${PROJECT_PGO_GENERATE}
+        )
+
+        target_link_options(${target}
+            PRIVATE
+                ${PROJECT_PGO_GENERATE}
+        )
+    elseif(PGO_MODE STREQUAL "USE")
+        target_compile_options(${target}
+            PRIVATE
+                ${PROJECT_PGO_USE}
+        )
+
+        # BOLT rewrites the binary from its relocations.
+        if(ENABLE_BOLT)
+            target_link_options(${target}
+                PRIVATE
+                    -Wl,--emit-relocs
+            )
+        endif()
+    endif()
+endfunction()
+
+# Adds a <target>-pgo target driving the whole pipeline from this build tree:
+# an instrumented build in pgo-instrumented/, a training run of target with
+# the given arguments, the profile merge, and an optimized build in
+# pgo-optimized/. With ENABLE_BOLT and llvm-bolt on the PATH, the optimized
+# executable is trained once more and rewritten as <target>.bolt.
+function(setup_target_training target)
+    if(NOT PGO_MODE STREQUAL "OFF" OR NOT PROJECT_PGO_GENERATE)
+        return()
+    endif()
+
+    set(instrumented ${CMAKE_BINARY_DIR}/pgo-instrumented)
+    set(optimized ${CMAKE_BINARY_DIR}/pgo-optimized)
+
+    set(forwarded
+        -DCMAKE_BUILD_TYPE=Release
+        -DCMAKE_C_COMPILER=${CMAKE_C_COMPILER}
+        -DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER}
+        -DPGO_PROFILE_DIR=${PGO_PROFILE_DIR}
+        -DENABLE_BOLT=${ENABLE_BOLT}
+    )
+
+    foreach(variable IN ITEMS CMAKE_TOOLCHAIN_FILE CMAKE_PREFIX_PATH CMAKE_CXX_STANDARD ENABLE_IPO OPTIMIZE_FOR_NATIVE ENABLE_MULTIVERSIONING USE_STATIC_STD)
+        if(DEFINED ${variable})
+            list(APPEND forwarded -D${variable}=${${variable}})
+        endif()
+    endforeach()
+
+    set(steps
+        COMMAND ${CMAKE_COMMAND} -E rm -rf ${PGO_PROFILE_DIR}
+        COMMAND ${CMAKE_COMMAND} -S ${CMAKE_SOURCE_DIR} -B ${instrumented} ${forwarded} -DPGO_MODE=GENERATE -DCMAKE_RUNTIME_OUTPUT_DIRECTORY=${instrumented}/bin -DCMAKE_LIBRARY_OUTPUT_DIRECTORY=${instrumented}/bin -DCMAKE_ARCHIVE_OUTPUT_DIRECTORY=${instrumented}/bin
+        COMMAND ${CMAKE_COMMAND} --build ${instrumented} --target ${target}
+        COMMAND ${instrumented}/bin/${target} ${ARGN}
+    )
+
+    if("${CMAKE_CXX_COMPILER_ID}" MATCHES "Clang")
+        if(NOT LLVM_PROFDATA)
+            message(STATUS "llvm-profdata not found, ${target}-pgo is not available")
+            return()
+        endif()
+
+        list(APPEND steps
+            COMMAND ${LLVM_PROFDATA} merge -output=${PGO_PROFILE_DIR}/default.profdata ${PGO_PROFILE_DIR}
+        )
+    endif()
+
+    list(APPEND steps
+        COMMAND ${CMAKE_COMMAND} -S ${CMAKE_SOURCE_DIR} -B ${optimized} ${forwarded} -DPGO_MODE=USE -DCMAKE_RUNTIME_OUTPUT_DIRECTORY=${optimized}/bin -DCMAKE_LIBRARY_OUTPUT_DIRECTORY=${optimized}/bin -DCMAKE_ARCHIVE_OUTPUT_DIRECTORY=${optimized}/bin
+        COMMAND ${CMAKE_COMMAND} --build ${optimized}
+    )
+
+    if(ENABLE_BOLT AND LLVM_BOLT)
+        set(binary ${optimized}/bin/${target})
+
+        list(APPEND steps
+            COMMAND ${LLVM_BOLT} ${binary} -instrument -instrumentation-file=${PGO_PROFILE_DIR}/${target}.fdata -o ${binary}.instrumented
+            COMMAND ${binary}.instrumented ${ARGN}
+            COMMAND ${LLVM_BOLT} ${binary} -o ${binary}.bolt -data=${PGO_PROFILE_DIR}/${target}.fdata -reorder-blocks=ext-tsp -reorder-functions=hfsort -split-functions -split-all-cold -icf=1
+        )
+    elseif(ENABLE_BOLT)
+        message(STATUS "llvm-bolt not found, ${target}-pgo skips the BOLT step")
+    endif()
+
+    add_custom_target(${target}-pgo
+        ${steps}
+        WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+        USES_TERMINAL
+        VERBATIM
+    )
+endfunction()
@@ -1,12 +1,14 @@
 include(Linker)
 include(Optimization)
+include(ProfileGuided)
 include(Sanitizer)
 include(Warnings)
 
 function(setup_executable target)
-    set(multiValueArgs SOURCES INCLUDES DEPENDENCIES INSTALL PROPERTIES DEFINES)
+    set(options TRAINING)
+    set(multiValueArgs SOURCES INCLUDES DEPENDENCIES INSTALL PROPERTIES DEFINES TRAINING_ARGUMENTS)
 
-    cmake_parse_arguments(TARGET "" "" "${multiValueArgs}" ${ARGN})
+    cmake_parse_arguments(TARGET "${options}" "" "${multiValueArgs}" ${ARGN})
 
     _setup_executable_sources(${target})
     _setup_target_includes(${target})
@@ -19,10 +21,15 @@ function(setup_executable target)
 
     setup_target_link_strategy(${target})
     setup_target_optimizations(${target})
+    setup_target_profile(${target})
 
     setup_target_warnings(${target})
     setup_target_for_sanitizer(${target})
 
+    if(TARGET_TRAINING)
+        setup_target_training(${target} ${TARGET_TRAINING_ARGUMENTS})
+    endif()
+
     if(TARGET_INSTALL)
         install(TARGETS ${target} DESTINATION ${TARGET_INSTALL})
     endif()
@@ -48,6 +55,7 @@ function(setup_library target)
 
     setup_target_link_strategy(${target})
     setup_target_optimizations(${target})
+    setup_target_profile(${target})
 
     setup_target_warnings(${target})
     setup_target_for_sanitizer(${target})
@@ -0,0 +1,317 @@
+#ifndef ADMIN_SHELL_HPP
+#define ADMIN_SHELL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "command_registry.hpp"
+#include "endpoint.hpp"
+#include "reactor.hpp"
+#include "result.hpp"
+#include "scan.hpp"
+#include "socket.hpp"
+#include "thread.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Serves a command registry over a TCP or Unix socket, so a running process
+// can be inspected with nc or socat. Everything - accepting, reading and the
+// commands themselves - runs on the shell's own thread, never on the hot
+// path; output lines are sent to the client as the handler produces them,
+// and queued while the client is slow to read.
+class admin_shell_t
+{
+public:
+    explicit admin_shell_t(command_registry_t& registry)
+        : m_registry(registry)
+    {}
+
+    admin_shell_t(const admin_shell_t& /* that */) = delete;
+    admin_shell_t(admin_shell_t&& /* that */) = delete;
+
+    ~admin_shell_t()
+    {
+        stop();
+    }
+
+    admin_shell_t& operator=(const admin_shell_t& /* that */) = delete;
+    admin_shell_t& operator=(admin_shell_t&& /* that */) = delete;
+
+    [[nodiscard]] status_t start(const endpoint_t& endpoint)
+    {
+        stop();
+
+        // A stale socket file left by a previous run would fail the bind.
+        if (endpoint.family() == AF_UNIX)
+        {
+            m_path = endpoint.to_string();
+            ::unlink(m_path.c_str());
+        }
+
+        m_listener = socket_t(endpoint.family());
+
+        if (auto result = m_listener.bind(endpoint); !result)
+        {
+            return fail_t(result.error());
+        }
+
+        if (auto result = m_listener.listen(); !result)
+        {
+            return fail_t(result.error());
+        }
+
+        m_reactor = std::make_unique<reactor_t>();
+        m_reactor->add(m_listener.descriptor(), POLLIN, [this](short /* events */) { accept(); });
+
+        m_thread = thread_t([this](std::stop_token token) { m_reactor->run(std::move(token)); });
+        std::ignore = m_thread.set_name("admin-shell");
+
+        return {};
+    }
+
+    void stop()
+    {
+        if (!m_reactor)
+        {
+            return;
+        }
+
+        m_thread.request_stop();
+        m_thread.join();
+
+        m_clients.clear();
+        m_listener.close();
+        m_reactor.reset();
+
+        if (!m_path.empty())
+        {
+            ::unlink(m_path.c_str());
+            m_path.clear();
+        }
+    }
+
+private:
+    static constexpr std::string_view prompt = "> ";
+    static constexpr std::size_t read_size = 4096;
+
+    // A client typing a line longer than this, or not reading its output
+    // while this much is queued, is disconnected rather than allowed to
+    // grow the shell without bound.
+    static constexpr std::size_t max_input = 64 * 1024;
+    static constexpr std::size_t max_output = 1024 * 1024;
+
+    struct client_t
+    {
+        socket_t socket;
+
+        std::string pending{};
+        std::string unsent{};
+
+        bool writing = false;
+        bool failed = false;
+    };
+
+    void accept()
+    {
+        auto accepted = m_listener.accept();
+
+        // Clients never block the loop: output they do not read yet is
+        // queued and flushed when the socket turns writable.
+        if (!accepted || !accepted.value().set_blocking(false))
+        {
+            return;
+        }
+
+        auto descriptor = accepted.value().descriptor();
+        auto& client = m_clients.insert_or_assign(descriptor, client_t{std::move(accepted.value())}).first->second;
+
+        queue(client, prompt);
+
+        if (client.failed)
+        {
+            m_clients.erase(descriptor);
+            return;
+        }
+
+        watch(descriptor, client);
+    }
+
+    void service(int descriptor, short events)
+    {
+        auto& client = m_clients.at(descriptor);
+
+        if ((events & POLLOUT) != 0 && !flush(client))
+        {
+            disconnect(descriptor);
+            return;
+        }
+
+        // Hang-ups and errors arrive without POLLIN; both end the session,
+        // as do a failed read, end of stream and the quit command.
+        if ((events & (POLLIN | POLLOUT)) == 0 || ((events & POLLIN) != 0 && !receive(client)))
+        {
+            disconnect(descriptor);
+            return;
+        }
+
+        if (client.writing != !client.unsent.empty())
+        {
+            watch(descriptor, client);
+        }
+    }
+
+    // Returns false when the client has to be disconnected.
+    bool receive(client_t& client)
+    {
+        std::array<char, read_size> buffer{};
+        auto length = client.socket.recv(buffer.data(), buffer.size());
+
+        if (!length)
+        {
+            return would_block(length.error());
+        }
+
+        if (length.value() == 0)
+        {
+            return false;
+        }
+
+        client.pending.append(buffer.data(), length.value());
+
+        auto rest = std::string_view(client.pending);
+
+        for (auto found = scan::find_byte(scan::bytes(rest), std::byte{'\n'}); found != scan::npos; found = scan::find_byte(scan::bytes(rest), std::byte{'\n'}))
+        {
+            auto line = rest.substr(0, found);
+            rest.remove_prefix(found + 1);
+
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+
+            tokens_t tokens(line);
+
+            if (!tokens.empty() && (tokens.front() == "quit" || tokens.front() == "exit"))
+            {
+                return false;
+            }
+
+            m_registry.execute(line, [this, &client](std::string_view output) {
+                queue(client, output);
+                queue(client, "\n");
+            });
+
+            queue(client, prompt);
+
+            if (client.failed)
+            {
+                return false;
+            }
+        }
+
+        client.pending.erase(0, client.pending.size() - rest.size());
+        return client.pending.size() <= max_input;
+    }
+
+    void disconnect(int descriptor)
+    {
+        m_reactor->remove(descriptor);
+        m_clients.erase(descriptor);
+    }
+
+    // Polls for writability only while output is queued.
+    void watch(int descriptor, client_t& client)
+    {
+        client.writing = !client.unsent.empty();
+
+        auto events = static_cast<short>(client.writing ? POLLIN | POLLOUT : POLLIN);
+        m_reactor->add(descriptor, events, [this, descriptor](short ready) { service(descriptor, ready); });
+    }
+
+    // Sends directly while nothing is queued, so output keeps its order;
+    // marks the client failed once it is gone or over the output cap.
+    void queue(client_t& client, std::string_view text)
+    {
+        if (client.failed)
+        {
+            return;
+        }
+
+        if (client.unsent.empty() && !send_some(client.socket, text))
+        {
+            client.failed = true;
+            return;
+        }
+
+        if (client.unsent.size() + text.size() > max_output)
+        {
+            client.failed = true;
+            return;
+        }
+
+        client.unsent.append(text);
+    }
+
+    static bool flush(client_t& client)
+    {
+        auto rest = std::string_view(client.unsent);
+        auto sent = send_some(client.socket, rest);
+
+        client.unsent.erase(0, client.unsent.size() - rest.size());
+        return sent;
+    }
+
+    // Sends as much of text as the socket takes without blocking and drops
+    // it from text; false once the peer is gone.
+    static bool send_some(const socket_t& socket, std::string_view& text)
+    {
+        while (!text.empty())
+        {
+            auto sent = socket.send(text);
+
+            if (!sent)
+            {
+                return would_block(sent.error());
+            }
+
+            text.remove_prefix(sent.value());
+        }
+
+        return true;
+    }
+
+    static bool would_block(const std::error_code& code) noexcept
+    {
+        return code == std::errc::operation_would_block || code == std::errc::resource_unavailable_try_again || code == std::errc::interrupted;
+    }
+
+    command_registry_t& m_registry;
+
+    std::unique_ptr<reactor_t> m_reactor;
+    socket_t m_listener;
+    std::unordered_map<int, client_t> m_clients;
+    std::string m_path;
+
+    thread_t m_thread;
+};
+
+#endif  // ADMIN_SHELL_HPP
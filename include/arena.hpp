@@ -0,0 +1,209 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+/// \cond
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Bump allocator over a list of upstream blocks. Deallocation is a no-op and
+// reset() rewinds to the first block while keeping every block, so an arena
+// reused per request stops touching the upstream allocator once warmed up.
+class arena_t
+{
+    static constexpr std::size_t default_block_size = 64 * 1024;
+
+    struct block_t
+    {
+        block_t* next;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t header_size = (sizeof(block_t) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+public:
+    explicit arena_t(std::size_t block_size = default_block_size,
+                     std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_upstream(upstream)
+        , m_block_size(block_size)
+    {}
+
+    arena_t(const arena_t& /* that */) = delete;
+    arena_t(arena_t&& /* that */) = delete;
+
+    ~arena_t()
+    {
+        release();
+    }
+
+    arena_t& operator=(const arena_t& /* that */) = delete;
+    arena_t& operator=(arena_t&& /* that */) = delete;
+
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+    {
+        if (auto* memory = bump(size, alignment))
+        {
+            return memory;
+        }
+
+        while (m_current && m_current->next)
+        {
+            select(m_current->next);
+
+            if (auto* memory = bump(size, alignment))
+            {
+                return memory;
+            }
+        }
+
+        select(grow(size + alignment));
+        return bump(size, alignment);
+    }
+
+    template <typename T, typename... Args>
+    [[nodiscard]] T* create(Args&&... args)
+    {
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    void reset() noexcept
+    {
+        if (m_head)
+        {
+            select(m_head);
+        }
+
+        m_used = 0;
+    }
+
+    void release() noexcept
+    {
+        while (m_head)
+        {
+            auto* next = m_head->next;
+            m_upstream->deallocate(m_head, header_size + m_head->size, alignof(std::max_align_t));
+            m_head = next;
+        }
+
+        m_current = nullptr;
+        m_tail = nullptr;
+
+        m_cursor = nullptr;
+        m_end = nullptr;
+
+        m_used = 0;
+        m_reserved = 0;
+    }
+
+    [[nodiscard]] std::size_t used() const noexcept
+    {
+        return m_used;
+    }
+
+    [[nodiscard]] std::size_t reserved() const noexcept
+    {
+        return m_reserved;
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept
+    {
+        return m_upstream;
+    }
+
+private:
+    void* bump(std::size_t size, std::size_t alignment) noexcept
+    {
+        auto address = reinterpret_cast<std::uintptr_t>(m_cursor);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto aligned = (address + alignment - 1) & ~(alignment - 1);
+
+        if (!m_cursor || aligned + size > reinterpret_cast<std::uintptr_t>(m_end))  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        {
+            return nullptr;
+        }
+
+        m_used += aligned + size - address;
+        m_cursor = reinterpret_cast<std::byte*>(aligned + size);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+
+        return reinterpret_cast<void*>(aligned);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+    }
+
+    void select(block_t* block) noexcept
+    {
+        auto* data = reinterpret_cast<std::byte*>(block) + header_size;  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        m_current = block;
+        m_cursor = data;
+        m_end = data + block->size;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    block_t* grow(std::size_t minimum)
+    {
+        auto size = std::max(m_block_size, minimum);
+        auto* block = ::new (m_upstream->allocate(header_size + size, alignof(std::max_align_t))) block_t{nullptr, size};
+
+        if (m_tail)
+        {
+            m_tail->next = block;
+        }
+        else
+        {
+            m_head = block;
+        }
+
+        m_tail = block;
+        m_reserved += size;
+
+        return block;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    std::size_t m_block_size;
+
+    block_t* m_head = nullptr;
+    block_t* m_tail = nullptr;
+    block_t* m_current = nullptr;
+
+    std::byte* m_cursor = nullptr;
+    std::byte* m_end = nullptr;
+
+    std::size_t m_used = 0;
+    std::size_t m_reserved = 0;
+};
+
+class arena_resource_t : public std::pmr::memory_resource
+{
+public:
+    explicit arena_resource_t(arena_t& arena) noexcept
+        : m_arena(std::addressof(arena))
+    {}
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        return m_arena->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* /* ptr */, std::size_t /* bytes */, std::size_t /* alignment */) override
+    {}
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override
+    {
+        return this == std::addressof(that);
+    }
+
+    arena_t* m_arena;
+};
+
+#endif  // ARENA_HPP
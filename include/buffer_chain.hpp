@@ -0,0 +1,341 @@
+#ifndef BUFFER_CHAIN_HPP
+#define BUFFER_CHAIN_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "pool.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Sequence of views into reference-counted, pooled slabs. Copies and slices
+// share slabs instead of bytes; a slab returns to the pool of the thread that
+// drops the last reference. Only a slab referenced by a single chain is ever
+// written to, so shared bytes are immutable.
+class buffer_chain_t
+{
+    struct slab_t
+    {
+        std::atomic<std::uint32_t> refs;
+        pool_t* pool;
+    };
+
+    static constexpr std::size_t header_size = utils::cache_line_size;
+
+public:
+    static constexpr std::size_t slab_size = 16 * 1024;
+    static constexpr std::size_t slab_capacity = slab_size - header_size;
+
+    class segment_t
+    {
+    public:
+        segment_t(const segment_t& that) noexcept
+            : m_slab(that.m_slab)
+            , m_offset(that.m_offset)
+            , m_length(that.m_length)
+        {
+            m_slab->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        segment_t(segment_t&& that) noexcept
+            : m_slab(std::exchange(that.m_slab, nullptr))
+            , m_offset(that.m_offset)
+            , m_length(that.m_length)
+        {}
+
+        ~segment_t()
+        {
+            if (m_slab && m_slab->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                m_slab->pool->deallocate(m_slab);
+            }
+        }
+
+        segment_t& operator=(const segment_t& that) noexcept
+        {
+            segment_t copy(that);
+            swap(copy);
+
+            return *this;
+        }
+
+        segment_t& operator=(segment_t&& that) noexcept
+        {
+            segment_t moved(std::move(that));
+            swap(moved);
+
+            return *this;
+        }
+
+        void swap(segment_t& that) noexcept
+        {
+            std::swap(m_slab, that.m_slab);
+            std::swap(m_offset, that.m_offset);
+            std::swap(m_length, that.m_length);
+        }
+
+        [[nodiscard]] std::span<const std::byte> data() const noexcept
+        {
+            return {bytes() + m_offset, m_length};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_length;
+        }
+
+    private:
+        friend class buffer_chain_t;
+
+        segment_t(slab_t* slab, std::size_t offset, std::size_t length) noexcept
+            : m_slab(slab)
+            , m_offset(offset)
+            , m_length(length)
+        {}
+
+        [[nodiscard]] std::byte* bytes() const noexcept
+        {
+            return reinterpret_cast<std::byte*>(m_slab) + header_size;  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        [[nodiscard]] bool exclusive() const noexcept
+        {
+            return m_slab->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        slab_t* m_slab;
+
+        std::size_t m_offset;
+        std::size_t m_length;
+    };
+
+    explicit buffer_chain_t(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_segments(resource)
+        , m_pool(std::addressof(default_pool()))
+    {}
+
+    // Slabs are carved from the given pool, so its objects must hold a whole
+    // slab_size bytes with at least the alignment of the slab header.
+    buffer_chain_t(pool_t& pool, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_segments(resource)
+        , m_pool(std::addressof(pool))
+    {
+        if (pool.object_size() < slab_size || pool.alignment() < alignof(slab_t))
+        {
+            panic("buffer_chain_t: pool objects cannot hold a slab");
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] std::span<const segment_t> segments() const noexcept
+    {
+        return m_segments;
+    }
+
+    [[nodiscard]] std::span<std::byte> prepare(std::size_t minimum = 1)
+    {
+        if (m_segments.empty() || !m_segments.back().exclusive() || tailroom() < std::max<std::size_t>(minimum, 1))
+        {
+            m_segments.push_back(make_segment(0));
+        }
+
+        auto& tail = m_segments.back();
+        return {tail.bytes() + tail.m_offset + tail.m_length, tailroom()};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    void commit(std::size_t length) noexcept
+    {
+        m_segments.back().m_length += length;
+        m_size += length;
+    }
+
+    void append(std::span<const std::byte> data)
+    {
+        while (!data.empty())
+        {
+            auto buffer = prepare();
+            auto length = std::min(buffer.size(), data.size());
+
+            std::memcpy(buffer.data(), data.data(), length);
+            commit(length);
+
+            data = data.subspan(length);
+        }
+    }
+
+    void append(const buffer_chain_t& that)
+    {
+        m_segments.insert(m_segments.end(), that.m_segments.begin(), that.m_segments.end());
+        m_size += that.m_size;
+    }
+
+    void append(buffer_chain_t&& that)
+    {
+        m_segments.insert(m_segments.end(), std::make_move_iterator(that.m_segments.begin()), std::make_move_iterator(that.m_segments.end()));
+        m_size += std::exchange(that.m_size, 0);
+
+        that.m_segments.clear();
+    }
+
+    void prepend(std::span<const std::byte> data)
+    {
+        while (!data.empty())
+        {
+            if (m_segments.empty() || !m_segments.front().exclusive() || m_segments.front().m_offset == 0)
+            {
+                m_segments.insert(m_segments.begin(), make_segment(slab_capacity));
+            }
+
+            auto& head = m_segments.front();
+            auto length = std::min(head.m_offset, data.size());
+
+            head.m_offset -= length;
+            head.m_length += length;
+
+            std::memcpy(head.bytes() + head.m_offset, data.data() + data.size() - length, length);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+            m_size += length;
+            data = data.first(data.size() - length);
+        }
+    }
+
+    [[nodiscard]] buffer_chain_t slice(std::size_t offset, std::size_t length) const
+    {
+        buffer_chain_t result(*m_pool, m_segments.get_allocator().resource());
+
+        for (const auto& segment : m_segments)
+        {
+            if (length == 0)
+            {
+                break;
+            }
+
+            if (offset >= segment.m_length)
+            {
+                offset -= segment.m_length;
+                continue;
+            }
+
+            auto& part = result.m_segments.emplace_back(segment);
+            auto count = std::min(segment.m_length - offset, length);
+
+            part.m_offset += offset;
+            part.m_length = count;
+
+            result.m_size += count;
+            length -= count;
+            offset = 0;
+        }
+
+        return result;
+    }
+
+    void consume(std::size_t length)
+    {
+        length = std::min(length, m_size);
+        m_size -= length;
+
+        auto it = m_segments.begin();
+
+        while (length != 0 && length >= it->m_length)
+        {
+            length -= it->m_length;
+            ++it;
+        }
+
+        m_segments.erase(m_segments.begin(), it);
+
+        if (length != 0)
+        {
+            m_segments.front().m_offset += length;
+            m_segments.front().m_length -= length;
+        }
+    }
+
+    std::size_t copy_to(std::span<std::byte> output, std::size_t offset = 0) const noexcept
+    {
+        std::size_t copied = 0;
+
+        for (const auto& segment : m_segments)
+        {
+            if (offset >= segment.m_length)
+            {
+                offset -= segment.m_length;
+                continue;
+            }
+
+            auto data = segment.data().subspan(offset);
+            auto length = std::min(data.size(), output.size() - copied);
+
+            std::memcpy(output.data() + copied, data.data(), length);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+            copied += length;
+            offset = 0;
+
+            if (copied == output.size())
+            {
+                break;
+            }
+        }
+
+        return copied;
+    }
+
+    void clear() noexcept
+    {
+        m_segments.clear();
+        m_size = 0;
+    }
+
+    static pool_t& default_pool()
+    {
+        static pool_t pool(slab_size, utils::cache_line_size, 64);
+        return pool;
+    }
+
+private:
+    [[nodiscard]] std::size_t tailroom() const noexcept
+    {
+        const auto& tail = m_segments.back();
+        return slab_capacity - tail.m_offset - tail.m_length;
+    }
+
+    segment_t make_segment(std::size_t offset)
+    {
+        auto* slab = ::new (m_pool->allocate()) slab_t{{1}, m_pool};
+        return {slab, offset, 0};
+    }
+
+    std::pmr::vector<segment_t> m_segments;
+    std::size_t m_size = 0;
+
+    pool_t* m_pool;
+};
+
+#endif  // BUFFER_CHAIN_HPP
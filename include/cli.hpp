@@ -6,9 +6,19 @@
 
 #include <replxx.hxx>
 
+#include "command_table.hpp"
+#include "reactor.hpp"
+#include "scan.hpp"
+
 /// \cond
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory_resource>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <utility>
 
 /// \endcond
 
@@ -18,14 +28,89 @@
 class cli
 {
 public:
+    using command_handler_t = std::function<void(std::string_view command)>;
+
+    // While attached to a reactor, output is posted to the loop thread so
+    // lines from different threads never interleave and callers never block.
     static void println(std::string_view message)
     {
         auto& self = instance();
 
+        if (auto* reactor = self.m_reactor.load(std::memory_order_acquire))
+        {
+            reactor->post([line = std::string(message) + '\n'] { write(line); });
+            return;
+        }
+
         self.m_terminal.print(message.data());  // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
         self.m_terminal.print("\n");            // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
     }
 
+    // Asynchronous console: stdin is watched by the reactor and every
+    // completed line is handed to handler on the loop thread. replxx has no
+    // way to be fed keystrokes incrementally, so in this mode lines come
+    // from the terminal's own line discipline; they still go to history.
+    static void attach(reactor_t& reactor, command_handler_t handler)
+    {
+        auto& self = instance();
+
+        self.m_handler = std::move(handler);
+        self.m_pending.clear();
+
+        reactor.add(input_descriptor, POLLIN, [](short events) { instance().receive(events); });
+        self.m_reactor.store(&reactor, std::memory_order_release);
+
+        write(prompt);
+    }
+
+    // Same, executing every line through a command table or registry and
+    // printing its output.
+    template <command_set Commands>
+    static void attach(reactor_t& reactor, const Commands& commands)
+    {
+        attach(reactor, [&commands](std::string_view command) { commands.execute(command, println); });
+    }
+
+    // Tab completion and inline hints for the prompt, generated from a
+    // command table or registry that must outlive the console.
+    template <command_set Commands>
+    static void complete_from(const Commands& commands)
+    {
+        auto& self = instance();
+
+        self.m_terminal.set_completion_callback([&commands](const std::string& line, int& context) {
+            context = word_length(line);
+
+            replxx::Replxx::completions_t completions;
+
+            for (const auto& candidate : commands.complete(line))
+            {
+                completions.emplace_back(candidate);
+            }
+
+            return completions;
+        });
+
+        self.m_terminal.set_hint_callback([&commands](const std::string& line, int& context, replxx::Replxx::Color& color) {
+            context = word_length(line);
+            color = replxx::Replxx::Color::GRAY;
+
+            // A hint for an empty word would list every command on each keystroke.
+            return context == 0 ? replxx::Replxx::hints_t() : commands.complete(line);
+        });
+    }
+
+    // Loop thread only.
+    static void detach()
+    {
+        auto& self = instance();
+
+        if (auto* reactor = self.m_reactor.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            reactor->remove(input_descriptor);
+        }
+    }
+
     static std::string input()
     {
         auto& self = instance();
@@ -40,6 +125,20 @@ public:
         return prompt;
     }
 
+    static std::pmr::string input(std::pmr::memory_resource* resource)
+    {
+        auto& self = instance();
+        const auto* prompt = self.m_terminal.input("> ");
+
+        if (!prompt)
+        {
+            return std::pmr::string(resource);
+        }
+
+        self.m_terminal.history_add(prompt);
+        return {prompt, resource};
+    }
+
     static void save(std::string_view file)
     {
         auto& self = instance();
@@ -53,8 +152,74 @@ public:
     }
 
 private:
+    static constexpr int input_descriptor = STDIN_FILENO;
+    static constexpr int output_descriptor = STDOUT_FILENO;
+    static constexpr std::string_view prompt = "> ";
+
+    static constexpr std::size_t read_size = 4096;
+
     cli() = default;
 
+    static void write(std::string_view text)
+    {
+        while (!text.empty())
+        {
+            auto written = ::write(output_descriptor, text.data(), text.size());
+
+            if (written <= 0)
+            {
+                return;
+            }
+
+            text.remove_prefix(static_cast<std::size_t>(written));
+        }
+    }
+
+    static int word_length(std::string_view line) noexcept
+    {
+        auto start = line.find_last_of(" \t");
+        return static_cast<int>(start == std::string_view::npos ? line.size() : line.size() - start - 1);
+    }
+
+    void receive(short events)
+    {
+        std::array<char, read_size> buffer{};
+        auto length = (events & POLLIN) != 0 ? ::read(input_descriptor, buffer.data(), buffer.size()) : 0;
+
+        if (length <= 0)
+        {
+            detach();
+            return;
+        }
+
+        m_pending.append(buffer.data(), static_cast<std::size_t>(length));
+
+        // Lines are dispatched from a local copy: a handler may attach again,
+        // which resets m_pending and replaces m_handler.
+        auto pending = std::exchange(m_pending, {});
+        auto rest = std::string_view(pending);
+
+        for (auto found = scan::find_byte(scan::bytes(rest), std::byte{'\n'}); found != scan::npos; found = scan::find_byte(scan::bytes(rest), std::byte{'\n'}))
+        {
+            auto line = rest.substr(0, found);
+            rest.remove_prefix(found + 1);
+
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+
+            m_terminal.history_add(std::string(line));
+
+            auto handler = m_handler;
+            handler(line);
+
+            write(prompt);
+        }
+
+        m_pending.append(rest);
+    }
+
     static cli& instance()
     {
         static cli instance;
@@ -62,6 +227,10 @@ private:
     }
 
     replxx::Replxx m_terminal;
+
+    std::atomic<reactor_t*> m_reactor{nullptr};
+    command_handler_t m_handler;
+    std::string m_pending;
 };
 
 #endif  // CLI_HPP
@@ -0,0 +1,152 @@
+#ifndef COMMAND_REGISTRY_HPP
+#define COMMAND_REGISTRY_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "command_table.hpp"
+
+/// \cond
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Named console commands shared by the local terminal and the admin shell.
+// Handlers write their result line by line through the output callback, so a
+// remote client sees a long dump while it is being produced.
+class command_registry_t
+{
+public:
+    using output_t = command_t::output_t;
+    using handler_t = std::function<void(std::span<const std::string_view> arguments, const output_t& output)>;
+    using completion_t = std::function<std::vector<std::string>(std::span<const std::string_view> arguments)>;
+
+    void add(std::string name, std::string help, handler_t handler, completion_t completion = {})
+    {
+        std::unique_lock lock(m_mutex);
+        m_commands.insert_or_assign(std::move(name), entry_t{std::move(help), std::move(handler), std::move(completion)});
+    }
+
+    // Runs one command line. Returns false for blank lines and unknown
+    // commands; "help" lists the registered commands unless overridden.
+    bool execute(std::string_view line, const output_t& output) const
+    {
+        tokens_t tokens(line);
+
+        if (tokens.empty())
+        {
+            return false;
+        }
+
+        std::shared_lock lock(m_mutex);
+        auto found = m_commands.find(tokens.front());
+
+        if (found == m_commands.end())
+        {
+            if (tokens.front() == "help")
+            {
+                for (const auto& [name, command] : m_commands)
+                {
+                    output(name + " - " + command.help);
+                }
+
+                return true;
+            }
+
+            output("unknown command: " + std::string(tokens.front()));
+            return false;
+        }
+
+        // Copy out so a handler may register further commands.
+        auto handler = found->second.handler;
+        lock.unlock();
+
+        handler(tokens.arguments(), output);
+        return true;
+    }
+
+    // Candidates for the last word of line: command names while the first
+    // word is typed, the command's own completion afterwards. Completions
+    // see the arguments before the word being completed.
+    [[nodiscard]] std::vector<std::string> complete(std::string_view line) const
+    {
+        tokens_t tokens(line);
+        std::vector<std::string> candidates;
+
+        auto open = line.empty() || tokens_t::is_separator(line.back());
+        auto word = open || tokens.empty() ? std::string_view() : tokens.back();
+
+        std::shared_lock lock(m_mutex);
+
+        if (tokens.size() + (open ? 1 : 0) == 1)
+        {
+            for (auto it = m_commands.lower_bound(word); it != m_commands.end() && it->first.starts_with(word); ++it)
+            {
+                candidates.push_back(it->first);
+            }
+
+            return candidates;
+        }
+
+        auto found = m_commands.find(tokens.front());
+
+        if (found == m_commands.end() || !found->second.completion)
+        {
+            return candidates;
+        }
+
+        auto completion = found->second.completion;
+        lock.unlock();
+
+        for (auto& candidate : completion(open ? tokens.arguments() : tokens.arguments().first(tokens.size() - 2)))
+        {
+            if (candidate.starts_with(word))
+            {
+                candidates.push_back(std::move(candidate));
+            }
+        }
+
+        return candidates;
+    }
+
+    // Makes a compile-time table reachable from the admin shell as well.
+    template <std::size_t N>
+    void add(const command_table_t<N>& table)
+    {
+        for (const auto& command : table.commands())
+        {
+            completion_t completion;
+
+            if (command.completion)
+            {
+                completion = command.completion;
+            }
+
+            add(std::string(command.name), std::string(command.help), command.handler, std::move(completion));
+        }
+    }
+
+private:
+    struct entry_t
+    {
+        std::string help;
+        handler_t handler;
+        completion_t completion;
+    };
+
+    mutable std::shared_mutex m_mutex;
+    std::map<std::string, entry_t, std::less<>> m_commands;
+};
+
+#endif  // COMMAND_REGISTRY_HPP
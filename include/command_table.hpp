@@ -0,0 +1,379 @@
+#ifndef COMMAND_TABLE_HPP
+#define COMMAND_TABLE_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "utils.hpp"
+
+/// \cond
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Whitespace-separated words of a command line as views into it; nothing is
+// allocated. Past max_tokens the last token keeps the rest of the line.
+class tokens_t
+{
+public:
+    static constexpr std::size_t max_tokens = 16;
+
+    constexpr explicit tokens_t(std::string_view line) noexcept
+    {
+        std::size_t position = 0;
+
+        while (m_size < max_tokens)
+        {
+            while (position < line.size() && is_separator(line[position]))
+            {
+                position += 1;
+            }
+
+            if (position == line.size())
+            {
+                return;
+            }
+
+            auto start = position;
+
+            if (m_size + 1 == max_tokens)
+            {
+                position = line.size();
+
+                while (is_separator(line[position - 1]))
+                {
+                    position -= 1;
+                }
+            }
+
+            while (position < line.size() && !is_separator(line[position]))
+            {
+                position += 1;
+            }
+
+            m_tokens.at(m_size++) = line.substr(start, position - start);
+        }
+    }
+
+    [[nodiscard]] constexpr std::span<const std::string_view> span() const noexcept
+    {
+        return std::span(m_tokens).first(m_size);
+    }
+
+    // Everything after the command name.
+    [[nodiscard]] constexpr std::span<const std::string_view> arguments() const noexcept
+    {
+        return empty() ? span() : span().subspan(1);
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] constexpr std::string_view front() const noexcept
+    {
+        return m_tokens.front();
+    }
+
+    [[nodiscard]] constexpr std::string_view back() const noexcept
+    {
+        return m_tokens.at(m_size - 1);
+    }
+
+    [[nodiscard]] constexpr const std::string_view* begin() const noexcept
+    {
+        return m_tokens.data();
+    }
+
+    [[nodiscard]] constexpr const std::string_view* end() const noexcept
+    {
+        return m_tokens.data() + m_size;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    static constexpr bool is_separator(char character) noexcept
+    {
+        return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+    }
+
+private:
+    std::array<std::string_view, max_tokens> m_tokens{};
+    std::size_t m_size = 0;
+};
+
+struct command_t
+{
+    using output_t = std::function<void(std::string_view line)>;
+    using handler_t = void (*)(std::span<const std::string_view> arguments, const output_t& output);
+    using completion_t = std::vector<std::string> (*)(std::span<const std::string_view> arguments);
+
+    std::string_view name;
+    std::string_view help;
+
+    handler_t handler = nullptr;
+    completion_t completion = nullptr;
+};
+
+// Anything the console and the admin shell can drive. execute() matches
+// whole command names; only a command_table_t built with abbreviations also
+// accepts an unambiguous prefix, so the same line may fail on another set.
+template <typename T>
+concept command_set = requires(const T& commands, std::string_view line, const command_t::output_t& output) {
+    { commands.execute(line, output) } -> std::same_as<bool>;
+    { commands.complete(line) } -> std::same_as<std::vector<std::string>>;
+};
+
+// Fixed set of commands laid out in a prefix trie, normally built as a
+// constexpr variable so a bad table fails to compile:
+//
+//     constexpr command_table_t commands(std::array{
+//         command_t{"stats", "dump statistics", &stats},
+//         command_t{"quit", "leave", &quit},
+//     });
+//
+// Lookup walks one node per character of the name. With abbreviations
+// enabled, an unambiguous prefix ("st") selects its command like a full name
+// does; an exact name always wins over a longer one it prefixes.
+template <std::size_t N>
+class command_table_t
+{
+public:
+    static constexpr std::size_t max_name_length = 32;
+
+    constexpr explicit command_table_t(const std::array<command_t, N>& commands, bool abbreviations = false)
+        : m_commands(commands)
+        , m_abbreviations(abbreviations)
+    {
+        // Node indices, command indices included, must stay below the
+        // sentinel.
+        static_assert(max_nodes <= none, "command table too large");
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            insert(i);
+        }
+    }
+
+    [[nodiscard]] constexpr const command_t* find(std::string_view name) const noexcept
+    {
+        auto index = walk(name);
+
+        if (index == none || name.empty())
+        {
+            return nullptr;
+        }
+
+        // Descend while the prefix still names a single command.
+        while (m_nodes.at(index).command == none)
+        {
+            if (!m_abbreviations || m_nodes.at(index).count != 1)
+            {
+                return nullptr;
+            }
+
+            index = m_nodes.at(index).child;
+        }
+
+        return &m_commands.at(m_nodes.at(index).command);
+    }
+
+    // Returns false for blank lines and unknown or ambiguous commands;
+    // "help" lists the table unless it defines its own.
+    bool execute(std::string_view line, const command_t::output_t& output) const
+    {
+        tokens_t tokens(line);
+
+        if (tokens.empty())
+        {
+            return false;
+        }
+
+        const auto* command = find(tokens.front());
+
+        // A longer name starting with "help" does not take over the listing.
+        if (tokens.front() == "help" && (!command || command->name != "help"))
+        {
+            for (const auto& item : m_commands)
+            {
+                output(std::string(item.name) + " - " + std::string(item.help));
+            }
+
+            return true;
+        }
+
+        if (!command)
+        {
+            output("unknown command: " + std::string(tokens.front()));
+            return false;
+        }
+
+        command->handler(tokens.arguments(), output);
+        return true;
+    }
+
+    // Candidates for the last word of line, in name order while the command
+    // is typed and from the command's completion afterwards.
+    [[nodiscard]] std::vector<std::string> complete(std::string_view line) const
+    {
+        tokens_t tokens(line);
+        std::vector<std::string> candidates;
+
+        auto open = line.empty() || tokens_t::is_separator(line.back());
+        auto word = open || tokens.empty() ? std::string_view() : tokens.back();
+
+        if (tokens.size() + (open ? 1 : 0) == 1)
+        {
+            if (auto index = walk(word); index != none)
+            {
+                collect(index, candidates);
+            }
+
+            return candidates;
+        }
+
+        const auto* command = find(tokens.front());
+
+        if (!command || !command->completion)
+        {
+            return candidates;
+        }
+
+        for (auto& candidate : command->completion(open ? tokens.arguments() : tokens.arguments().first(tokens.size() - 2)))
+        {
+            if (candidate.starts_with(word))
+            {
+                candidates.push_back(std::move(candidate));
+            }
+        }
+
+        return candidates;
+    }
+
+    [[nodiscard]] constexpr std::span<const command_t> commands() const noexcept
+    {
+        return m_commands;
+    }
+
+private:
+    using index_t = std::uint16_t;
+
+    static constexpr index_t none = 0xffff;
+    static constexpr std::size_t max_nodes = N * max_name_length + 1;
+
+    // Children hang off child as a sibling list kept in label order, so a
+    // depth-first walk yields names sorted.
+    struct node_t
+    {
+        char label = '\0';
+
+        index_t child = none;
+        index_t sibling = none;
+        index_t command = none;
+
+        // Commands at or below this node.
+        index_t count = 0;
+    };
+
+    constexpr void insert(std::size_t command)
+    {
+        auto name = m_commands.at(command).name;
+
+        if (name.empty() || name.size() > max_name_length || !m_commands.at(command).handler)
+        {
+            panic("invalid command in table");
+        }
+
+        index_t index = 0;
+        m_nodes.front().count += 1;
+
+        for (auto label : name)
+        {
+            auto* link = &m_nodes.at(index).child;
+
+            while (*link != none && m_nodes.at(*link).label < label)
+            {
+                link = &m_nodes.at(*link).sibling;
+            }
+
+            if (*link == none || m_nodes.at(*link).label != label)
+            {
+                auto created = static_cast<index_t>(m_used++);
+
+                m_nodes.at(created).label = label;
+                m_nodes.at(created).sibling = *link;
+                *link = created;
+            }
+
+            index = *link;
+            m_nodes.at(index).count += 1;
+        }
+
+        if (m_nodes.at(index).command != none)
+        {
+            panic("command registered twice");
+        }
+
+        m_nodes.at(index).command = static_cast<index_t>(command);
+    }
+
+    [[nodiscard]] constexpr index_t walk(std::string_view prefix) const noexcept
+    {
+        index_t index = 0;
+
+        for (auto label : prefix)
+        {
+            index = m_nodes.at(index).child;
+
+            while (index != none && m_nodes.at(index).label != label)
+            {
+                index = m_nodes.at(index).sibling;
+            }
+
+            if (index == none)
+            {
+                return none;
+            }
+        }
+
+        return index;
+    }
+
+    void collect(index_t index, std::vector<std::string>& names) const
+    {
+        const auto& node = m_nodes.at(index);
+
+        if (node.command != none)
+        {
+            names.emplace_back(m_commands.at(node.command).name);
+        }
+
+        for (auto child = node.child; child != none; child = m_nodes.at(child).sibling)
+        {
+            collect(child, names);
+        }
+    }
+
+    std::array<command_t, N> m_commands;
+    bool m_abbreviations;
+
+    std::array<node_t, max_nodes> m_nodes{};
+    std::size_t m_used = 1;
+};
+
+#endif  // COMMAND_TABLE_HPP
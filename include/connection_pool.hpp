@@ -0,0 +1,312 @@
+#ifndef CONNECTION_POOL_HPP
+#define CONNECTION_POOL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "endpoint.hpp"
+#include "result.hpp"
+#include "socket.hpp"
+
+/// \cond
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Client-side pool of keep-alive connections per endpoint. Waiters are served
+// in arrival order, and idle connections are reused most-recent first so the
+// oldest ones age out through idle_timeout.
+class connection_pool_t
+{
+    using clock_t = std::chrono::steady_clock;
+
+    struct idle_t
+    {
+        socket_t socket;
+        clock_t::time_point since;
+    };
+
+    struct route_t
+    {
+        std::deque<idle_t> idle;
+        std::size_t active = 0;
+
+        std::size_t next_ticket = 0;
+        std::size_t serving = 0;
+
+        // Tickets whose waiters timed out before their turn.
+        std::unordered_set<std::size_t> abandoned;
+
+        std::condition_variable ready;
+    };
+
+public:
+    struct options_t
+    {
+        std::size_t max_connections = 16;
+        std::size_t max_idle = 4;
+
+        std::chrono::milliseconds idle_timeout{30000};
+        std::chrono::milliseconds connect_timeout{1000};
+        std::chrono::milliseconds acquire_timeout{5000};
+    };
+
+    class lease_t
+    {
+    public:
+        lease_t() = default;
+
+        lease_t(const lease_t& /* that */) = delete;
+
+        lease_t(lease_t&& that) noexcept
+            : m_pool(std::exchange(that.m_pool, nullptr))
+            , m_route(std::exchange(that.m_route, nullptr))
+            , m_socket(std::move(that.m_socket))
+            , m_reusable(that.m_reusable)
+        {}
+
+        ~lease_t()
+        {
+            if (m_pool)
+            {
+                m_pool->release(*m_route, std::move(*m_socket), m_reusable);
+            }
+        }
+
+        lease_t& operator=(const lease_t& /* that */) = delete;
+
+        lease_t& operator=(lease_t&& that) noexcept
+        {
+            lease_t moved(std::move(that));
+
+            std::swap(m_pool, moved.m_pool);
+            std::swap(m_route, moved.m_route);
+            std::swap(m_socket, moved.m_socket);
+            std::swap(m_reusable, moved.m_reusable);
+
+            return *this;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_pool != nullptr;
+        }
+
+        socket_t& operator*() noexcept
+        {
+            return *m_socket;
+        }
+
+        socket_t* operator->() noexcept
+        {
+            return std::addressof(*m_socket);
+        }
+
+        void discard() noexcept
+        {
+            m_reusable = false;
+        }
+
+    private:
+        friend class connection_pool_t;
+
+        lease_t(connection_pool_t* pool, route_t* route, socket_t socket)
+            : m_pool(pool)
+            , m_route(route)
+            , m_socket(std::move(socket))
+        {}
+
+        connection_pool_t* m_pool = nullptr;
+        route_t* m_route = nullptr;
+
+        std::optional<socket_t> m_socket;
+        bool m_reusable = true;
+    };
+
+    connection_pool_t()
+        : connection_pool_t(options_t())
+    {}
+
+    explicit connection_pool_t(options_t options)
+        : m_options(options)
+    {}
+
+    [[nodiscard]] result_t<lease_t, std::error_code> acquire(std::string_view addr, uint16_t port)
+    {
+        auto endpoint = endpoint_t::parse(addr, port);
+
+        if (!endpoint)
+        {
+            return fail_t(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        return acquire(*endpoint);
+    }
+
+    // Waits at most acquire_timeout for a turn at the endpoint, then reuses
+    // an idle connection or opens a new one within connect_timeout.
+    [[nodiscard]] result_t<lease_t, std::error_code> acquire(const endpoint_t& endpoint)
+    {
+        std::unique_lock lock(m_mutex);
+
+        auto& route = find_or_create(endpoint);
+        auto ticket = route.next_ticket++;
+
+        auto served = route.ready.wait_for(lock, m_options.acquire_timeout, [this, &route, ticket] {
+            return route.serving == ticket && (!route.idle.empty() || total(route) < m_options.max_connections);
+        });
+
+        if (!served)
+        {
+            // Let the waiters behind this ticket through.
+            if (route.serving == ticket)
+            {
+                advance(route);
+                route.ready.notify_all();
+            }
+            else
+            {
+                route.abandoned.insert(ticket);
+            }
+
+            return fail_t(std::make_error_code(std::errc::timed_out));
+        }
+
+        advance(route);
+        route.active += 1;
+
+        while (!route.idle.empty())
+        {
+            auto item = std::move(route.idle.back());
+            route.idle.pop_back();
+
+            if (healthy(item))
+            {
+                route.ready.notify_all();
+                return success_t(lease_t(this, std::addressof(route), std::move(item.socket)));
+            }
+        }
+
+        route.ready.notify_all();
+        lock.unlock();
+
+        socket_t socket(endpoint.family());
+
+        if (auto connected = socket.connect(endpoint, m_options.connect_timeout); !connected)
+        {
+            forfeit(lock, route);
+            return fail_t(connected.error());
+        }
+
+        if (auto keepalive = socket.set_keepalive(true); !keepalive)
+        {
+            forfeit(lock, route);
+            return fail_t(keepalive.error());
+        }
+
+        return success_t(lease_t(this, std::addressof(route), std::move(socket)));
+    }
+
+    void prune()
+    {
+        std::lock_guard lock(m_mutex);
+
+        for (auto& [endpoint, route] : m_routes)
+        {
+            std::erase_if(route->idle, [this](const auto& item) { return !healthy(item); });
+            route->ready.notify_all();
+        }
+    }
+
+    [[nodiscard]] std::size_t idle(const endpoint_t& endpoint)
+    {
+        std::lock_guard lock(m_mutex);
+        return find_or_create(endpoint).idle.size();
+    }
+
+private:
+    static std::size_t total(const route_t& route) noexcept
+    {
+        return route.active + route.idle.size();
+    }
+
+    [[nodiscard]] bool healthy(const idle_t& item) const
+    {
+        if (clock_t::now() - item.since > m_options.idle_timeout)
+        {
+            return false;
+        }
+
+        // An idle connection has nothing to read; readiness means the peer
+        // closed it or sent unsolicited data, either way it is unusable.
+        auto ready = item.socket.pool(0);
+        return ready && ready.value() == 0;
+    }
+
+    static void advance(route_t& route)
+    {
+        route.serving += 1;
+
+        while (route.abandoned.erase(route.serving) != 0)
+        {
+            route.serving += 1;
+        }
+    }
+
+    // Gives back the slot reserved for a connection that could not be opened.
+    static void forfeit(std::unique_lock<std::mutex>& lock, route_t& route)
+    {
+        lock.lock();
+
+        route.active -= 1;
+        route.ready.notify_all();
+    }
+
+    route_t& find_or_create(const endpoint_t& endpoint)
+    {
+        auto& route = m_routes[endpoint];
+
+        if (!route)
+        {
+            route = std::make_unique<route_t>();
+        }
+
+        return *route;
+    }
+
+    void release(route_t& route, socket_t socket, bool reusable)
+    {
+        std::lock_guard lock(m_mutex);
+
+        route.active -= 1;
+
+        if (reusable && route.idle.size() < m_options.max_idle)
+        {
+            route.idle.push_back(idle_t{std::move(socket), clock_t::now()});
+        }
+
+        route.ready.notify_all();
+    }
+
+    options_t m_options;
+
+    std::mutex m_mutex;
+    std::unordered_map<endpoint_t, std::unique_ptr<route_t>> m_routes;
+};
+
+#endif  // CONNECTION_POOL_HPP
@@ -0,0 +1,66 @@
+#ifndef CRASH_HPP
+#define CRASH_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "result.hpp"
+
+/// \cond
+#include <cstddef>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Fatal signal handling. On SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT
+// (which panic() raises) the handler writes the signal, a backtrace and,
+// optionally, the state of every thread to stderr and the crash file, runs
+// the registered hooks (logger flushes its queues this way) and re-raises
+// the signal so the exit status and core dump stay intact.
+//
+// The handler itself only uses async-signal-safe calls on storage reserved
+// at install time. Hooks are the exception and are bounded by an alarm; if
+// it fires, the original signal is still the one that ends the process.
+// Link executables with -rdynamic (ENABLE_EXPORTS) for function names in
+// the backtrace; otherwise frames show as module+offset for addr2line.
+class crash
+{
+public:
+    using hook_t = void (*)(int descriptor);
+
+    static constexpr std::size_t max_hooks = 8;
+
+    struct options_t
+    {
+        // Appended to; opened at install time, never from the handler.
+        const char* file = nullptr;
+
+        // Dump id, name and scheduler state of every thread of the process.
+        bool threads = false;
+
+        // Seconds the hooks get before the process is killed regardless.
+        unsigned hook_timeout = 5;
+    };
+
+    [[nodiscard]] static status_t install();
+    [[nodiscard]] static status_t install(const options_t& options);
+
+    // Gives the calling thread an alternate signal stack, so a stack
+    // overflow is reported instead of killing the thread silently. install()
+    // does this for the thread that calls it and thread_t for every thread
+    // it starts afterwards; other threads have to call it themselves.
+    [[nodiscard]] static status_t protect_this_thread();
+
+    [[nodiscard]] static bool installed() noexcept;
+
+    // Hooks receive the crash file descriptor (or -1) and run in order of
+    // registration. Returns false once max_hooks are registered.
+    static bool on_crash(hook_t hook) noexcept;
+
+    // Writes a panic message the same way, ahead of the abort() that follows.
+    static void annotate(const char* message, const char* file, int line) noexcept;
+};
+
+#endif  // CRASH_HPP
@@ -0,0 +1,228 @@
+#ifndef ENDPOINT_HPP
+#define ENDPOINT_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#if defined(_WIN32)
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+#endif
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Socket address parsed once and passed by value. Covers IPv4, IPv6 and, on
+// POSIX systems, Unix domain socket paths.
+class endpoint_t
+{
+public:
+    endpoint_t() = default;
+
+    endpoint_t(const sockaddr* addr, std::size_t length) noexcept
+        : m_length(static_cast<socklen_t>(std::min(length, sizeof(m_storage))))
+    {
+        std::memcpy(&m_storage, addr, m_length);
+    }
+
+    [[nodiscard]] static std::optional<endpoint_t> parse(std::string_view addr, uint16_t port)
+    {
+        if (addr.size() > 2 && addr.front() == '[' && addr.back() == ']')
+        {
+            addr = addr.substr(1, addr.size() - 2);
+        }
+
+        std::array<char, INET6_ADDRSTRLEN + 1> text{};
+
+        if (addr.size() >= text.size())
+        {
+            return std::nullopt;
+        }
+
+        std::copy(addr.begin(), addr.end(), text.begin());
+
+        endpoint_t endpoint;
+
+        if (addr.find(':') == std::string_view::npos)
+        {
+            auto& ipv4 = endpoint.as<sockaddr_in>();
+
+            ipv4.sin_family = AF_INET;
+            ipv4.sin_port = htons(port);
+
+            if (::inet_pton(AF_INET, text.data(), &ipv4.sin_addr) != 1)
+            {
+                return std::nullopt;
+            }
+
+            endpoint.m_length = sizeof(sockaddr_in);
+        }
+        else
+        {
+            auto& ipv6 = endpoint.as<sockaddr_in6>();
+
+            ipv6.sin6_family = AF_INET6;
+            ipv6.sin6_port = htons(port);
+
+            if (::inet_pton(AF_INET6, text.data(), &ipv6.sin6_addr) != 1)
+            {
+                return std::nullopt;
+            }
+
+            endpoint.m_length = sizeof(sockaddr_in6);
+        }
+
+        return endpoint;
+    }
+
+    [[nodiscard]] static endpoint_t any(uint16_t port, bool ipv6 = true)
+    {
+        auto endpoint = parse(ipv6 ? "::" : "0.0.0.0", port);
+        return *endpoint;
+    }
+
+#if !defined(_WIN32)
+    [[nodiscard]] static std::optional<endpoint_t> local(std::string_view path)
+    {
+        endpoint_t endpoint;
+        auto& address = endpoint.as<sockaddr_un>();
+
+        if (path.empty() || path.size() >= sizeof(address.sun_path))
+        {
+            return std::nullopt;
+        }
+
+        address.sun_family = AF_UNIX;
+        std::copy(path.begin(), path.end(), std::begin(address.sun_path));
+
+        endpoint.m_length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size() + 1);
+        return endpoint;
+    }
+#endif
+
+    [[nodiscard]] int family() const noexcept
+    {
+        return m_length == 0 ? AF_UNSPEC : m_storage.ss_family;
+    }
+
+    [[nodiscard]] const sockaddr* data() const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<const sockaddr*>(&m_storage);
+    }
+
+    [[nodiscard]] socklen_t size() const noexcept
+    {
+        return m_length;
+    }
+
+    [[nodiscard]] uint16_t port() const noexcept
+    {
+        switch (family())
+        {
+            case AF_INET:
+                return ntohs(as<sockaddr_in>().sin_port);
+
+            case AF_INET6:
+                return ntohs(as<sockaddr_in6>().sin6_port);
+
+            default:
+                return 0;
+        }
+    }
+
+    void set_port(uint16_t port) noexcept
+    {
+        switch (family())
+        {
+            case AF_INET:
+                as<sockaddr_in>().sin_port = htons(port);
+                break;
+
+            case AF_INET6:
+                as<sockaddr_in6>().sin6_port = htons(port);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    [[nodiscard]] std::string to_string() const
+    {
+        std::array<char, INET6_ADDRSTRLEN> text{};
+
+        switch (family())
+        {
+            case AF_INET:
+                ::inet_ntop(AF_INET, &as<sockaddr_in>().sin_addr, text.data(), text.size());
+                return std::string(text.data()) + ':' + std::to_string(port());
+
+            case AF_INET6:
+                ::inet_ntop(AF_INET6, &as<sockaddr_in6>().sin6_addr, text.data(), text.size());
+                return '[' + std::string(text.data()) + "]:" + std::to_string(port());
+
+#if !defined(_WIN32)
+            case AF_UNIX:
+                return {static_cast<const char*>(as<sockaddr_un>().sun_path)};
+#endif
+
+            default:
+                return {};
+        }
+    }
+
+    friend bool operator==(const endpoint_t& lhs, const endpoint_t& rhs) noexcept
+    {
+        return lhs.m_length == rhs.m_length && std::memcmp(&lhs.m_storage, &rhs.m_storage, lhs.m_length) == 0;
+    }
+
+private:
+    template <typename T>
+    T& as() noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return *reinterpret_cast<T*>(&m_storage);
+    }
+
+    template <typename T>
+    [[nodiscard]] const T& as() const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return *reinterpret_cast<const T*>(&m_storage);
+    }
+
+    sockaddr_storage m_storage{};
+    socklen_t m_length = 0;
+};
+
+template <>
+struct std::hash<endpoint_t>
+{
+    std::size_t operator()(const endpoint_t& endpoint) const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* bytes = reinterpret_cast<const char*>(endpoint.data());
+        return std::hash<std::string_view>()(std::string_view(bytes, endpoint.size()));
+    }
+};
+
+#endif  // ENDPOINT_HPP
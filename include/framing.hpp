@@ -0,0 +1,344 @@
+#ifndef FRAMING_HPP
+#define FRAMING_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "buffer_chain.hpp"
+#include "result.hpp"
+#include "scan.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+namespace framing
+{
+    struct frame_t
+    {
+        std::size_t offset;
+        std::size_t length;
+        std::size_t consumed;
+    };
+
+    inline constexpr std::size_t invalid_length = std::numeric_limits<std::size_t>::max();
+
+    class fixed_t
+    {
+    public:
+        static constexpr std::size_t header_size = 4;
+
+        [[nodiscard]] std::optional<frame_t> measure(std::span<const std::byte> data) const noexcept
+        {
+            if (data.size() < header_size)
+            {
+                return std::nullopt;
+            }
+
+            std::size_t length = 0;
+
+            for (std::size_t i = 0; i < header_size; ++i)
+            {
+                length = (length << 8U) | std::to_integer<std::size_t>(data[i]);
+            }
+
+            if (data.size() - header_size < length)
+            {
+                return frame_t{header_size, length, invalid_length};
+            }
+
+            return frame_t{header_size, length, header_size + length};
+        }
+
+        void wrap(buffer_chain_t& chain) const
+        {
+            auto length = static_cast<std::uint32_t>(chain.size());
+            std::array<std::byte, header_size> header{};
+
+            for (std::size_t i = 0; i < header_size; ++i)
+            {
+                header.at(header_size - 1 - i) = static_cast<std::byte>(length >> (8U * i));
+            }
+
+            chain.prepend(header);
+        }
+    };
+
+    class varint_t
+    {
+    public:
+        static constexpr std::size_t max_header_size = 10;
+
+        [[nodiscard]] std::optional<frame_t> measure(std::span<const std::byte> data) const noexcept
+        {
+            std::size_t length = 0;
+
+            for (std::size_t i = 0; i < std::min(data.size(), max_header_size); ++i)
+            {
+                auto byte = std::to_integer<std::size_t>(data[i]);
+                length |= (byte & 0x7FU) << (7U * i);
+
+                if ((byte & 0x80U) == 0)
+                {
+                    auto header = i + 1;
+
+                    if (data.size() - header < length)
+                    {
+                        return frame_t{header, length, invalid_length};
+                    }
+
+                    return frame_t{header, length, header + length};
+                }
+            }
+
+            if (data.size() >= max_header_size)
+            {
+                return frame_t{max_header_size, invalid_length, invalid_length};
+            }
+
+            return std::nullopt;
+        }
+
+        void wrap(buffer_chain_t& chain) const
+        {
+            auto length = chain.size();
+
+            std::array<std::byte, max_header_size> header{};
+            std::size_t size = 0;
+
+            do
+            {
+                auto byte = length & 0x7FU;
+                length >>= 7U;
+
+                header.at(size++) = static_cast<std::byte>(length != 0 ? (byte | 0x80U) : byte);
+            } while (length != 0);
+
+            chain.prepend(std::span(header).first(size));
+        }
+    };
+
+    class delimited_t
+    {
+    public:
+        explicit delimited_t(std::byte delimiter = std::byte{'\n'})
+            : m_delimiter(delimiter)
+        {}
+
+        [[nodiscard]] std::optional<frame_t> measure(std::span<const std::byte> data) noexcept
+        {
+            auto found = scan::find_byte(data.subspan(m_searched), m_delimiter);
+
+            if (found == scan::npos)
+            {
+                m_searched = data.size();
+                return std::nullopt;
+            }
+
+            auto length = m_searched + found;
+            m_searched = 0;
+
+            return frame_t{0, length, length + 1};
+        }
+
+        void wrap(buffer_chain_t& chain) const
+        {
+            chain.append(std::span(&m_delimiter, 1));
+        }
+
+    private:
+        std::byte m_delimiter;
+        std::size_t m_searched = 0;
+    };
+}  // namespace framing
+
+// Contiguous receive buffer. Bytes are appended at the tail and consumed from
+// the head; unread bytes are moved to the front only when the tail runs out
+// of room, so at most one partial frame is ever copied.
+class stream_buffer_t
+{
+public:
+    explicit stream_buffer_t(std::size_t capacity, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_storage(capacity, resource)
+    {}
+
+    [[nodiscard]] std::span<std::byte> prepare(std::size_t minimum)
+    {
+        if (m_storage.size() - m_tail < minimum)
+        {
+            compact();
+        }
+
+        if (m_storage.size() - m_tail < minimum)
+        {
+            m_storage.resize(m_tail + minimum);
+        }
+
+        return std::span(m_storage).subspan(m_tail);
+    }
+
+    void commit(std::size_t length) noexcept
+    {
+        m_tail += length;
+    }
+
+    [[nodiscard]] std::span<const std::byte> data() const noexcept
+    {
+        return std::span(m_storage).subspan(m_head, m_tail - m_head);
+    }
+
+    void consume(std::size_t length) noexcept
+    {
+        m_head += length;
+
+        if (m_head == m_tail)
+        {
+            m_head = 0;
+            m_tail = 0;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_tail - m_head;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return m_storage.size();
+    }
+
+private:
+    void compact() noexcept
+    {
+        if (m_head == 0)
+        {
+            return;
+        }
+
+        std::memmove(m_storage.data(), m_storage.data() + m_head, m_tail - m_head);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        m_tail -= m_head;
+        m_head = 0;
+    }
+
+    std::pmr::vector<std::byte> m_storage;
+
+    std::size_t m_head = 0;
+    std::size_t m_tail = 0;
+};
+
+// Incremental parser: frames returned by next() point into the receive buffer
+// and stay valid until the next call to prepare() or fill().
+template <typename Protocol>
+class frame_parser_t
+{
+    static constexpr std::size_t default_max_frame = 16 * 1024 * 1024;
+    static constexpr std::size_t default_read_size = 16 * 1024;
+
+public:
+    explicit frame_parser_t(Protocol protocol = Protocol(),
+                            std::size_t max_frame = default_max_frame,
+                            std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_protocol(std::move(protocol))
+        , m_buffer(default_read_size * 4, resource)
+        , m_max_frame(max_frame)
+    {}
+
+    [[nodiscard]] std::span<std::byte> prepare(std::size_t minimum = default_read_size)
+    {
+        return m_buffer.prepare(std::max(minimum, m_pending));
+    }
+
+    void commit(std::size_t length) noexcept
+    {
+        m_buffer.commit(length);
+    }
+
+    // Zero means the transport reached end of stream.
+    template <utils::stream_transport Transport>
+    [[nodiscard]] result_t<std::size_t, std::error_code> fill(Transport& transport)
+    {
+        auto buffer = prepare();
+        auto result = transport.recv(buffer.data(), buffer.size());
+
+        if (!result)
+        {
+            return fail_t(result.error());
+        }
+
+        commit(result.value());
+        return success_t(result.value());
+    }
+
+    [[nodiscard]] std::optional<std::span<const std::byte>> next()
+    {
+        if (m_failed)
+        {
+            return std::nullopt;
+        }
+
+        auto data = m_buffer.data();
+        auto frame = m_protocol.measure(data);
+
+        if (!frame)
+        {
+            m_failed = data.size() > m_max_frame;
+            return std::nullopt;
+        }
+
+        if (frame->length > m_max_frame)
+        {
+            m_failed = true;
+            return std::nullopt;
+        }
+
+        if (frame->consumed == framing::invalid_length)
+        {
+            m_pending = frame->offset + frame->length - data.size();
+            return std::nullopt;
+        }
+
+        m_pending = 0;
+        m_buffer.consume(frame->consumed);
+
+        return data.subspan(frame->offset, frame->length);
+    }
+
+    [[nodiscard]] bool failed() const noexcept
+    {
+        return m_failed;
+    }
+
+    [[nodiscard]] std::size_t buffered() const noexcept
+    {
+        return m_buffer.size();
+    }
+
+private:
+    Protocol m_protocol;
+    stream_buffer_t m_buffer;
+
+    std::size_t m_max_frame;
+    std::size_t m_pending = 0;
+
+    bool m_failed = false;
+};
+
+#endif  // FRAMING_HPP
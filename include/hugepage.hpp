@@ -0,0 +1,299 @@
+#ifndef HUGEPAGE_HPP
+#define HUGEPAGE_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#if defined(__linux__)
+    #include <linux/mempolicy.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Memory resource handing out whole 2 MiB pages, meant as the upstream of
+// arena_t, pool_t and buffer pools rather than for small objects. Explicit
+// hugetlbfs pages are tried first when asked for; otherwise, or when the
+// reserve is empty, an aligned anonymous mapping is advised for transparent
+// huge pages. Regions can be locked and pre-faulted, so the first touch on
+// the hot path neither page-faults nor misses the TLB.
+class hugepage_resource_t : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t page_size = 2 * 1024 * 1024;
+    static constexpr int any_node = -1;
+
+    struct options_t
+    {
+        bool explicit_pages = false;
+        bool lock = false;
+        bool prefault = true;
+
+        int node = any_node;
+    };
+
+    // Bytes currently mapped, by how they are backed.
+    struct stats_t
+    {
+        std::size_t explicit_bytes;
+        std::size_t transparent_bytes;
+        std::size_t locked_bytes;
+    };
+
+    hugepage_resource_t()
+        : hugepage_resource_t(options_t())
+    {}
+
+    explicit hugepage_resource_t(options_t options)
+        : m_options(options)
+    {}
+
+    [[nodiscard]] stats_t stats() const noexcept
+    {
+        return {
+            m_explicit_bytes.load(std::memory_order_relaxed),
+            m_transparent_bytes.load(std::memory_order_relaxed),
+            m_locked_bytes.load(std::memory_order_relaxed),
+        };
+    }
+
+    [[nodiscard]] const options_t& options() const noexcept
+    {
+        return m_options;
+    }
+
+private:
+    struct region_t
+    {
+        bool explicit_pages;
+        bool locked;
+    };
+
+    static std::size_t round_up(std::size_t bytes) noexcept
+    {
+        return (std::max<std::size_t>(bytes, 1) + page_size - 1) & ~(page_size - 1);
+    }
+
+#if defined(__linux__)
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (alignment > page_size)
+        {
+            throw std::bad_alloc();
+        }
+
+        auto size = round_up(bytes);
+        auto* memory = m_options.explicit_pages ? map_explicit(size) : nullptr;
+
+        region_t region{memory != nullptr, false};
+
+        if (!memory)
+        {
+            memory = map_transparent(size);
+        }
+
+        region.locked = prepare(memory, size);
+
+        try
+        {
+            std::lock_guard lock(m_mutex);
+            m_regions.emplace(memory, region);
+        }
+        catch (...)
+        {
+            ::munmap(memory, size);
+            throw;
+        }
+
+        (region.explicit_pages ? m_explicit_bytes : m_transparent_bytes).fetch_add(size, std::memory_order_relaxed);
+
+        if (region.locked)
+        {
+            m_locked_bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+
+        return memory;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t /* alignment */) override
+    {
+        auto size = round_up(bytes);
+        region_t region{};
+
+        {
+            std::lock_guard lock(m_mutex);
+
+            auto found = m_regions.find(ptr);
+
+            if (found == m_regions.end())
+            {
+                panic("hugepage_resource_t: unknown region");
+            }
+
+            region = found->second;
+
+            m_regions.erase(found);
+        }
+
+        (region.explicit_pages ? m_explicit_bytes : m_transparent_bytes).fetch_sub(size, std::memory_order_relaxed);
+
+        if (region.locked)
+        {
+            m_locked_bytes.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        // Unmapping drops the lock as well.
+        ::munmap(ptr, size);
+    }
+
+    static void* map_explicit(std::size_t size) noexcept
+    {
+        auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+
+    #if defined(MAP_HUGE_2MB)
+        flags |= MAP_HUGE_2MB;
+    #endif
+
+        auto* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        return memory == MAP_FAILED ? nullptr : memory;
+    }
+
+    // Over-maps by one page and trims both ends, so the region starts on a
+    // 2 MiB boundary and khugepaged can back it with whole huge pages.
+    static void* map_transparent(std::size_t size)
+    {
+        auto* memory = ::mmap(nullptr, size + page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (memory == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        auto address = reinterpret_cast<std::uintptr_t>(memory);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto aligned = (address + page_size - 1) & ~(page_size - 1);
+
+        auto* begin = static_cast<std::byte*>(memory);
+        auto head = aligned - address;
+
+        if (head != 0)
+        {
+            ::munmap(begin, head);
+        }
+
+        ::munmap(begin + head + size, page_size - head);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        auto* region = begin + head;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    #if defined(MADV_HUGEPAGE)
+        ::madvise(region, size, MADV_HUGEPAGE);
+    #endif
+
+        return region;
+    }
+
+    // Returns whether the region ended up locked.
+    bool prepare(void* memory, std::size_t size)
+    {
+        // Placement must be set before the first touch to take effect.
+        if (m_options.node >= 0)
+        {
+            std::array<unsigned long, 16> mask{};  // NOLINT(google-runtime-int)
+            constexpr auto bits = 8 * sizeof(unsigned long);  // NOLINT(google-runtime-int)
+
+            auto node = static_cast<std::size_t>(m_options.node);
+
+            if (node < mask.size() * bits)
+            {
+                mask.at(node / bits) |= 1UL << (node % bits);
+
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+                ::syscall(SYS_mbind, memory, size, MPOL_PREFERRED, mask.data(), mask.size() * bits, 0);
+            }
+        }
+
+        if (m_options.lock && ::mlock(memory, size) == 0)
+        {
+            return true;  // mlock already faulted every page in.
+        }
+
+        if (m_options.prefault)
+        {
+            prefault(memory, size);
+        }
+
+        return false;
+    }
+
+    static void prefault(void* memory, std::size_t size) noexcept
+    {
+    #if defined(MADV_POPULATE_WRITE)
+        if (::madvise(memory, size, MADV_POPULATE_WRITE) == 0)
+        {
+            return;
+        }
+    #endif
+
+        // Older kernels: write one byte per base page.
+        auto step = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        auto* bytes = static_cast<volatile std::byte*>(memory);
+
+        for (std::size_t offset = 0; offset < size; offset += step)
+        {
+            bytes[offset] = std::byte{0};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+#else
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        auto size = round_up(bytes);
+        auto* memory = std::pmr::new_delete_resource()->allocate(size, std::max(alignment, alignof(std::max_align_t)));
+
+        m_transparent_bytes.fetch_add(size, std::memory_order_relaxed);
+        return memory;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        auto size = round_up(bytes);
+
+        m_transparent_bytes.fetch_sub(size, std::memory_order_relaxed);
+        std::pmr::new_delete_resource()->deallocate(ptr, size, std::max(alignment, alignof(std::max_align_t)));
+    }
+#endif
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override
+    {
+        return this == &that;
+    }
+
+    options_t m_options;
+
+    std::atomic<std::size_t> m_explicit_bytes{0};
+    std::atomic<std::size_t> m_transparent_bytes{0};
+    std::atomic<std::size_t> m_locked_bytes{0};
+
+    // How each live region is backed, so deallocation undoes the right
+    // counters. Only touched once per 2 MiB page, never per object.
+    std::mutex m_mutex;
+    std::unordered_map<void*, region_t> m_regions;
+};
+
+#endif  // HUGEPAGE_HPP
@@ -15,9 +15,12 @@
 
 #include <quill/core/PatternFormatterOptions.h>
 
+#include "crash.hpp"
+
 /// \cond
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 
 /// \endcond
@@ -57,6 +60,8 @@ public:
             auto file_sink = quill::Frontend::create_or_get_sink<quill::FileSink>(file, config);
             self.m_file_logger = quill::Frontend::create_or_get_logger("file", std::move(file_sink), format);
         }
+
+        std::ignore = crash::on_crash(flush);
     }
 
     static logger_t file()
@@ -74,6 +79,21 @@ public:
 private:
     logger() = default;
 
+    // Crash hook: waits for the backend to write out what was queued, so the
+    // last records before a crash reach the sinks.
+    static void flush(int /* descriptor */)
+    {
+        auto& self = instance();
+
+        for (auto* item : {self.m_console_logger, self.m_file_logger})
+        {
+            if (item)
+            {
+                item->flush_log();
+            }
+        }
+    }
+
     static logger& instance()
     {
         static logger instance;
@@ -0,0 +1,423 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "per_thread.hpp"
+#include "thread.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Counters and histograms are written into a per_thread_t block owned by the
+// calling thread, so the hot path is a relaxed load/store pair without any
+// read-modify-write. The blocks of every thread are summed only when the
+// registry is rendered; a block outlives its thread, so nothing is lost.
+class metrics
+{
+    static constexpr std::size_t max_slots = 1024;
+    static constexpr std::size_t max_gauges = 128;
+
+    enum class kind_t
+    {
+        counter,
+        gauge,
+        histogram
+    };
+
+    struct descriptor_t
+    {
+        std::string name;
+        std::string help;
+
+        kind_t kind;
+        std::size_t index;
+
+        std::vector<double> bounds;
+    };
+
+    struct block_t
+    {
+        std::array<std::atomic<std::uint64_t>, max_slots> values{};
+    };
+
+    struct alignas(utils::cache_line_size) gauge_slot_t
+    {
+        std::atomic<std::int64_t> value{};
+    };
+
+public:
+    class counter_t
+    {
+    public:
+        void add(std::uint64_t amount = 1) const noexcept
+        {
+            auto& slot = local().values[m_slot];
+            slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+    private:
+        friend class metrics;
+
+        explicit counter_t(std::size_t slot)
+            : m_slot(slot)
+        {}
+
+        std::size_t m_slot;
+    };
+
+    class gauge_t
+    {
+    public:
+        void set(std::int64_t value) const noexcept
+        {
+            m_slot->value.store(value, std::memory_order_relaxed);
+        }
+
+        void add(std::int64_t amount) const noexcept
+        {
+            m_slot->value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+    private:
+        friend class metrics;
+
+        explicit gauge_t(gauge_slot_t* slot)
+            : m_slot(slot)
+        {}
+
+        gauge_slot_t* m_slot;
+    };
+
+    class histogram_t
+    {
+    public:
+        void observe(double value) const noexcept
+        {
+            auto& block = local();
+
+            auto bucket = static_cast<std::size_t>(std::lower_bound(m_bounds, m_bounds + m_size, value) - m_bounds);
+            auto& count = block.values[m_slot + bucket];
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            auto& sum = block.values[m_slot + m_size + 1];
+            auto total = std::bit_cast<double>(sum.load(std::memory_order_relaxed)) + value;
+            sum.store(std::bit_cast<std::uint64_t>(total), std::memory_order_relaxed);
+        }
+
+    private:
+        friend class metrics;
+
+        histogram_t(std::size_t slot, const double* bounds, std::size_t size)
+            : m_slot(slot)
+            , m_bounds(bounds)
+            , m_size(size)
+        {}
+
+        std::size_t m_slot;
+
+        const double* m_bounds;
+        std::size_t m_size;
+    };
+
+    metrics(const metrics& /* that */) = delete;
+    metrics(metrics&& /* that */) = delete;
+
+    ~metrics()
+    {
+        shutdown();
+    }
+
+    metrics& operator=(const metrics& /* that */) = delete;
+    metrics& operator=(metrics&& /* that */) = delete;
+
+    static counter_t counter(std::string_view name, std::string_view help = "")
+    {
+        auto& self = instance();
+        std::lock_guard lock(self.m_mutex);
+
+        const auto& item = self.find_or_create(name, help, kind_t::counter, {});
+        return counter_t(item.index);
+    }
+
+    static gauge_t gauge(std::string_view name, std::string_view help = "")
+    {
+        auto& self = instance();
+        std::lock_guard lock(self.m_mutex);
+
+        const auto& item = self.find_or_create(name, help, kind_t::gauge, {});
+        return gauge_t(std::addressof(self.m_gauges[item.index]));
+    }
+
+    static histogram_t histogram(std::string_view name, std::vector<double> bounds, std::string_view help = "")
+    {
+        std::sort(bounds.begin(), bounds.end());
+
+        auto& self = instance();
+        std::lock_guard lock(self.m_mutex);
+
+        const auto& item = self.find_or_create(name, help, kind_t::histogram, std::move(bounds));
+        return histogram_t(item.index, item.bounds.data(), item.bounds.size());
+    }
+
+    static std::string render()
+    {
+        auto& self = instance();
+        std::lock_guard lock(self.m_mutex);
+
+        std::string text;
+
+        for (const auto& item : self.m_descriptors)
+        {
+            self.render(text, item);
+        }
+
+        return text;
+    }
+
+    static void start(std::string file, std::chrono::milliseconds interval)
+    {
+        auto& self = instance();
+
+        stop();
+
+        self.m_running = true;
+        self.m_exporter = thread_t([&self, file = std::move(file), interval] {
+            auto running = true;
+
+            // The lock only guards the wait: stop() must not queue behind a
+            // slow disk.
+            while (running)
+            {
+                {
+                    std::unique_lock lock(self.m_exporter_mutex);
+                    running = !self.m_wakeup.wait_for(lock, interval, [&self] { return !self.m_running; });
+                }
+
+                export_to(file);
+            }
+        });
+
+        std::ignore = self.m_exporter.set_name("metrics");
+    }
+
+    static void stop()
+    {
+        auto& self = instance();
+        self.shutdown();
+    }
+
+    static bool export_to(const std::string& file)
+    {
+        auto temporary = file + ".tmp";
+
+        {
+            std::ofstream stream(temporary, std::ios::trunc);
+            stream << render();
+
+            if (!stream)
+            {
+                return false;
+            }
+        }
+
+        return std::rename(temporary.c_str(), file.c_str()) == 0;
+    }
+
+private:
+    metrics() = default;
+
+    static metrics& instance()
+    {
+        static metrics instance;
+        return instance;
+    }
+
+    void shutdown()
+    {
+        {
+            std::lock_guard lock(m_exporter_mutex);
+            m_running = false;
+        }
+
+        m_wakeup.notify_all();
+
+        if (m_exporter.joinable())
+        {
+            m_exporter.join();
+        }
+    }
+
+    static block_t& local()
+    {
+        return instance().m_blocks.local();
+    }
+
+    const descriptor_t& find_or_create(std::string_view name, std::string_view help, kind_t kind, std::vector<double> bounds)
+    {
+        auto it = std::find_if(m_descriptors.begin(), m_descriptors.end(), [name](const auto& item) {
+            return item.name == name;
+        });
+
+        if (it != m_descriptors.end())
+        {
+            if (it->kind != kind)
+            {
+                panic("metric registered twice with different types");
+            }
+
+            return *it;
+        }
+
+        std::size_t index = 0;
+
+        if (kind == kind_t::gauge)
+        {
+            if (m_used_gauges == max_gauges)
+            {
+                panic("metrics gauge capacity exhausted");
+            }
+
+            index = m_used_gauges++;
+        }
+        else
+        {
+            auto width = (kind == kind_t::histogram) ? bounds.size() + 2 : 1;
+
+            if (m_used_slots + width > max_slots)
+            {
+                panic("metrics slot capacity exhausted");
+            }
+
+            index = m_used_slots;
+            m_used_slots += width;
+
+            if (kind == kind_t::histogram)
+            {
+                m_sum_slots.push_back(index + width - 1);
+            }
+        }
+
+        return m_descriptors.emplace_back(descriptor_t{std::string(name), std::string(help), kind, index, std::move(bounds)});
+    }
+
+    [[nodiscard]] std::uint64_t merge(std::size_t slot, std::uint64_t lhs, std::uint64_t rhs) const
+    {
+        if (std::find(m_sum_slots.begin(), m_sum_slots.end(), slot) == m_sum_slots.end())
+        {
+            return lhs + rhs;
+        }
+
+        return std::bit_cast<std::uint64_t>(std::bit_cast<double>(lhs) + std::bit_cast<double>(rhs));
+    }
+
+    [[nodiscard]] std::uint64_t collect(std::size_t slot) const
+    {
+        std::uint64_t total = 0;
+
+        m_blocks.for_each([this, slot, &total](const block_t& block) {
+            total = merge(slot, total, block.values[slot].load(std::memory_order_relaxed));
+        });
+
+        return total;
+    }
+
+    void render(std::string& text, const descriptor_t& item) const
+    {
+        static constexpr std::array<std::string_view, 3> types = {"counter", "gauge", "histogram"};
+
+        if (!item.help.empty())
+        {
+            text += "# HELP " + item.name + ' ' + item.help + '\n';
+        }
+
+        text += "# TYPE " + item.name + ' ';
+        text += types.at(static_cast<std::size_t>(item.kind));
+        text += '\n';
+
+        switch (item.kind)
+        {
+            case kind_t::counter:
+                text += item.name + ' ' + std::to_string(collect(item.index)) + '\n';
+                break;
+
+            case kind_t::gauge:
+                text += item.name + ' ' + std::to_string(m_gauges[item.index].value.load(std::memory_order_relaxed)) + '\n';
+                break;
+
+            case kind_t::histogram:
+            {
+                std::uint64_t count = 0;
+
+                for (std::size_t i = 0; i <= item.bounds.size(); ++i)
+                {
+                    count += collect(item.index + i);
+
+                    auto bound = (i < item.bounds.size()) ? format(item.bounds[i]) : std::string("+Inf");
+                    text += item.name + "_bucket{le=\"" + bound + "\"} " + std::to_string(count) + '\n';
+                }
+
+                auto sum = std::bit_cast<double>(collect(item.index + item.bounds.size() + 1));
+
+                text += item.name + "_sum " + format(sum) + '\n';
+                text += item.name + "_count " + std::to_string(count) + '\n';
+                break;
+            }
+        }
+    }
+
+    static std::string format(double value)
+    {
+        std::array<char, 32> buffer{};
+
+        auto [end, _] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        return {buffer.data(), end};
+    }
+
+    std::mutex m_mutex;
+
+    // A deque never moves its elements, so histogram_t can point into
+    // the bounds of its descriptor.
+    std::deque<descriptor_t> m_descriptors;
+    per_thread_t<block_t> m_blocks;
+
+    std::vector<std::size_t> m_sum_slots;
+
+    std::array<gauge_slot_t, max_gauges> m_gauges{};
+
+    std::size_t m_used_slots = 0;
+    std::size_t m_used_gauges = 0;
+
+    std::mutex m_exporter_mutex;
+    std::condition_variable m_wakeup;
+
+    bool m_running = false;
+    thread_t m_exporter;
+};
+
+#endif  // METRICS_HPP
@@ -0,0 +1,317 @@
+#ifndef MMAP_FILE_HPP
+#define MMAP_FILE_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "scan.hpp"
+
+/// \cond
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Read-only view of a whole file. Pages are faulted in lazily unless the map
+// is populated up front; advise() tells the kernel how the range is about to
+// be read so readahead can stay ahead of a sequential scan.
+class mmap_file_t
+{
+public:
+    enum class advice_t
+    {
+        normal,
+        sequential,
+        random,
+        willneed,
+        dontneed,
+        hugepage
+    };
+
+    // Forward iterator over delimiter-separated records. Records exclude the
+    // delimiter, and a trailing record without one is still returned.
+    class record_iterator_t
+    {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = std::span<const std::byte>;
+        using difference_type = std::ptrdiff_t;
+
+        record_iterator_t() = default;
+
+        record_iterator_t(std::span<const std::byte> data, std::byte delimiter) noexcept
+            : m_data(data)
+            , m_delimiter(delimiter)
+        {
+            advance();
+        }
+
+        [[nodiscard]] value_type operator*() const noexcept
+        {
+            return m_data.first(m_length);
+        }
+
+        record_iterator_t& operator++() noexcept
+        {
+            m_data = m_data.subspan(std::min(m_length + 1, m_data.size()));
+            advance();
+
+            return *this;
+        }
+
+        record_iterator_t operator++(int) noexcept
+        {
+            auto previous = *this;
+            ++*this;
+
+            return previous;
+        }
+
+        friend bool operator==(const record_iterator_t& lhs, const record_iterator_t& rhs) noexcept
+        {
+            return lhs.m_data.data() == rhs.m_data.data() && lhs.m_done == rhs.m_done;
+        }
+
+        friend bool operator==(const record_iterator_t& iterator, std::default_sentinel_t /* sentinel */) noexcept
+        {
+            return iterator.m_done;
+        }
+
+    private:
+        void advance() noexcept
+        {
+            if (m_data.empty())
+            {
+                m_done = true;
+                return;
+            }
+
+            auto found = scan::find_byte(m_data, m_delimiter);
+            m_length = found == scan::npos ? m_data.size() : found;
+        }
+
+        std::span<const std::byte> m_data;
+        std::byte m_delimiter{};
+
+        std::size_t m_length = 0;
+        bool m_done = false;
+    };
+
+    class records_t
+    {
+    public:
+        records_t(std::span<const std::byte> data, std::byte delimiter) noexcept
+            : m_data(data)
+            , m_delimiter(delimiter)
+        {}
+
+        [[nodiscard]] record_iterator_t begin() const noexcept
+        {
+            return {m_data, m_delimiter};
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        std::span<const std::byte> m_data;
+        std::byte m_delimiter;
+    };
+
+    mmap_file_t() = default;
+
+    mmap_file_t(const mmap_file_t& /* that */) = delete;
+
+    mmap_file_t(mmap_file_t&& that) noexcept
+        : m_memory(std::exchange(that.m_memory, nullptr))
+        , m_size(std::exchange(that.m_size, 0))
+    {}
+
+    ~mmap_file_t()
+    {
+        close();
+    }
+
+    mmap_file_t& operator=(const mmap_file_t& /* that */) = delete;
+
+    mmap_file_t& operator=(mmap_file_t&& that) noexcept
+    {
+        if (this != std::addressof(that))
+        {
+            close();
+
+            m_memory = std::exchange(that.m_memory, nullptr);
+            m_size = std::exchange(that.m_size, 0);
+        }
+
+        return *this;
+    }
+
+    [[nodiscard]] static std::optional<mmap_file_t> open(std::string_view path, bool populate = false)
+    {
+        auto name = std::string(path);
+        auto descriptor = ::open(name.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (descriptor == -1)
+        {
+            return std::nullopt;
+        }
+
+        struct stat status
+        {};
+
+        if (::fstat(descriptor, &status) == -1)
+        {
+            ::close(descriptor);
+            return std::nullopt;
+        }
+
+        mmap_file_t file;
+        file.m_size = static_cast<std::size_t>(status.st_size);
+
+        // An empty file cannot be mapped; it is still a valid, empty view.
+        if (file.m_size == 0)
+        {
+            ::close(descriptor);
+            return file;
+        }
+
+        int flags = MAP_PRIVATE;
+
+#if defined(MAP_POPULATE)
+        if (populate)
+        {
+            flags |= MAP_POPULATE;
+        }
+#else
+        (void)populate;
+#endif
+
+        auto* memory = ::mmap(nullptr, file.m_size, PROT_READ, flags, descriptor, 0);
+        ::close(descriptor);
+
+        if (memory == MAP_FAILED)
+        {
+            return std::nullopt;
+        }
+
+        file.m_memory = memory;
+        return file;
+    }
+
+    [[nodiscard]] bool advise(advice_t advice) const noexcept
+    {
+        return advise(advice, 0, m_size);
+    }
+
+    [[nodiscard]] bool advise(advice_t advice, std::size_t offset, std::size_t length) const noexcept
+    {
+        if (!m_memory || offset >= m_size)
+        {
+            return false;
+        }
+
+        // madvise wants a page-aligned start; widen the range down to it.
+        auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        auto start = offset - offset % page;
+        auto* address = static_cast<std::byte*>(m_memory) + start;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        length = std::min(length, m_size - offset) + (offset - start);
+
+        switch (advice)
+        {
+            case advice_t::normal:
+                return ::madvise(address, length, MADV_NORMAL) == 0;
+
+            case advice_t::sequential:
+                return ::madvise(address, length, MADV_SEQUENTIAL) == 0;
+
+            case advice_t::random:
+                return ::madvise(address, length, MADV_RANDOM) == 0;
+
+            case advice_t::willneed:
+                return ::madvise(address, length, MADV_WILLNEED) == 0;
+
+            case advice_t::dontneed:
+                return ::madvise(address, length, MADV_DONTNEED) == 0;
+
+            case advice_t::hugepage:
+#if defined(MADV_HUGEPAGE)
+                // File-backed huge pages need kernel support for read-only
+                // THP on the filesystem; callers get false otherwise.
+                return ::madvise(address, length, MADV_HUGEPAGE) == 0;
+#else
+                return false;
+#endif
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] std::span<const std::byte> data() const noexcept
+    {
+        return {static_cast<const std::byte*>(m_memory), m_memory ? m_size : 0};
+    }
+
+    [[nodiscard]] std::span<const std::byte> view(std::size_t offset, std::size_t length) const noexcept
+    {
+        auto bytes = data();
+
+        offset = std::min(offset, bytes.size());
+        return bytes.subspan(offset, std::min(length, bytes.size() - offset));
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] records_t records(std::byte delimiter) const noexcept
+    {
+        return {data(), delimiter};
+    }
+
+    [[nodiscard]] records_t lines() const noexcept
+    {
+        return records(std::byte{'\n'});
+    }
+
+    void close() noexcept
+    {
+        if (m_memory)
+        {
+            ::munmap(m_memory, m_size);
+        }
+
+        m_memory = nullptr;
+        m_size = 0;
+    }
+
+private:
+    void* m_memory = nullptr;
+    std::size_t m_size = 0;
+};
+
+#endif  // MMAP_FILE_HPP
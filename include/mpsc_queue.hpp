@@ -0,0 +1,97 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+/// \cond
+#include <atomic>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Multi-producer single-consumer queue. Producers push onto a lock-free
+// stack; the consumer takes the whole stack with one exchange and reverses
+// it, so items come out in push order and neither side ever blocks.
+template <typename T>
+class mpsc_queue_t
+{
+    struct node_t
+    {
+        T value;
+        node_t* next;
+    };
+
+public:
+    mpsc_queue_t() = default;
+
+    mpsc_queue_t(const mpsc_queue_t& /* that */) = delete;
+    mpsc_queue_t(mpsc_queue_t&& /* that */) = delete;
+
+    ~mpsc_queue_t()
+    {
+        std::ignore = drain([](T&& /* value */) {});
+    }
+
+    mpsc_queue_t& operator=(const mpsc_queue_t& /* that */) = delete;
+    mpsc_queue_t& operator=(mpsc_queue_t&& /* that */) = delete;
+
+    // Returns true when the queue was empty, i.e. when the consumer may be
+    // asleep and needs a wakeup; later pushes ride along with that one.
+    bool push(T value)
+    {
+        auto* node = new node_t{std::move(value), m_head.load(std::memory_order_relaxed)};
+
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        return node->next == nullptr;
+    }
+
+    template <typename F>
+    [[nodiscard]] std::size_t drain(F&& fn)
+    {
+        auto* node = m_head.exchange(nullptr, std::memory_order_acquire);
+        node_t* ordered = nullptr;
+
+        while (node)
+        {
+            auto* next = node->next;
+
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+
+        std::size_t count = 0;
+
+        while (ordered)
+        {
+            auto* next = ordered->next;
+
+            fn(std::move(ordered->value));
+            delete ordered;
+
+            ordered = next;
+            count += 1;
+        }
+
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    std::atomic<node_t*> m_head{nullptr};
+};
+
+#endif  // MPSC_QUEUE_HPP
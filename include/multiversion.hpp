@@ -0,0 +1,89 @@
+#ifndef MULTIVERSION_HPP
+#define MULTIVERSION_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+/// \cond
+#include <string_view>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** MACRO DEFINITIONS *******************************************************/
+
+// Marks a function to be compiled once per x86-64 level listed in the
+// MULTIVERSION_LEVELS CMake cache variable; the loader binds the best clone
+// through an ifunc before main. Without ENABLE_MULTIVERSIONING the function
+// is built once for the target's baseline.
+#if defined(TOOLBOX_TARGET_CLONES) && defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+    #define MULTIVERSION __attribute__((target_clones(TOOLBOX_TARGET_CLONES)))
+#else
+    #define MULTIVERSION
+#endif
+
+/*****************************************************************************/
+/*** FREE FUNCTIONS **********************************************************/
+
+namespace multiversion
+{
+    enum class level_t
+    {
+        baseline,
+        x86_64_v2,
+        x86_64_v3,
+        x86_64_v4
+    };
+
+    // The level the host CPU reaches, for hand-written kernel tables that
+    // need to agree with the clones the loader picked.
+    [[nodiscard]] inline level_t detect() noexcept
+    {
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+        static const level_t level = [] {
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("x86-64-v4"))
+            {
+                return level_t::x86_64_v4;
+            }
+
+            if (__builtin_cpu_supports("x86-64-v3"))
+            {
+                return level_t::x86_64_v3;
+            }
+
+            if (__builtin_cpu_supports("x86-64-v2"))
+            {
+                return level_t::x86_64_v2;
+            }
+
+            return level_t::baseline;
+        }();
+
+        return level;
+#else
+        return level_t::baseline;
+#endif
+    }
+
+    [[nodiscard]] constexpr std::string_view name(level_t level) noexcept
+    {
+        switch (level)
+        {
+            case level_t::x86_64_v2:
+                return "x86-64-v2";
+
+            case level_t::x86_64_v3:
+                return "x86-64-v3";
+
+            case level_t::x86_64_v4:
+                return "x86-64-v4";
+
+            default:
+                return "baseline";
+        }
+    }
+}  // namespace multiversion
+
+#endif  // MULTIVERSION_HPP
@@ -0,0 +1,521 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#if defined(__linux__)
+    #include <sched.h>
+#endif  // __linux__
+
+#include "thread.hpp"
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Persistent workers for data-parallel loops, created once instead of per
+// call. run() hands out task indices from a shared counter; the calling
+// thread works along and returns when every task is done. The first
+// exception a task throws skips the tasks not yet started and is rethrown
+// by run() once no thread is inside the job any more. Jobs run one at a
+// time: a run() issued from inside a task of the same pool runs inline
+// instead of deadlocking, and callers on other threads queue on a mutex.
+class parallel_pool_t
+{
+    // Type-erased view of the caller's task function; lives on its stack.
+    struct job_t
+    {
+        void (*invoke)(void* context, std::size_t task) = nullptr;
+        void* context = nullptr;
+        std::size_t tasks = 0;
+    };
+
+public:
+    struct options_t
+    {
+        // Workers besides the caller; 0 means one per allowed CPU, minus one.
+        std::size_t threads = 0;
+
+        // Pins worker i to the (i + 1)-th CPU the process may run on, leaving
+        // the first to the caller. Pinning errors are ignored.
+        bool pin = true;
+    };
+
+    parallel_pool_t()
+        : parallel_pool_t(options_t{})
+    {}
+
+    explicit parallel_pool_t(const options_t& options)
+    {
+        auto cpus = allowed_cpus();
+        auto threads = options.threads != 0 ? options.threads : cpus.size() - 1;
+
+        m_workers.reserve(threads);
+
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            auto& worker = m_workers.emplace_back([this](std::stop_token token) { work(token); });
+
+            std::ignore = worker.set_name("parallel-" + std::to_string(i));
+
+            if (options.pin && cpus.size() > 1)
+            {
+                std::ignore = worker.set_affinity(cpus[(i + 1) % cpus.size()]);
+            }
+        }
+    }
+
+    parallel_pool_t(const parallel_pool_t& /* that */) = delete;
+    parallel_pool_t(parallel_pool_t&& /* that */) = delete;
+
+    ~parallel_pool_t()
+    {
+        // thread_t requests the stop, which wakes the condition variable.
+        m_workers.clear();
+    }
+
+    parallel_pool_t& operator=(const parallel_pool_t& /* that */) = delete;
+    parallel_pool_t& operator=(parallel_pool_t&& /* that */) = delete;
+
+    // Used by the free functions below unless options name another pool.
+    static parallel_pool_t& shared()
+    {
+        static parallel_pool_t pool;
+        return pool;
+    }
+
+    // Threads that take part in a job, the caller included.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_workers.size() + 1;
+    }
+
+    // Calls fn(task) for every task in [0, tasks), in no particular order.
+    template <typename F>
+    void run(std::size_t tasks, F&& fn)
+    {
+        if (tasks == 0)
+        {
+            return;
+        }
+
+        if (tasks == 1 || m_workers.empty() || current() == this)
+        {
+            for (std::size_t task = 0; task < tasks; ++task)
+            {
+                fn(task);
+            }
+
+            return;
+        }
+
+        job_t job;
+        job.invoke = [](void* context, std::size_t task) { (*static_cast<std::remove_reference_t<F>*>(context))(task); };
+        job.context = std::addressof(fn);
+        job.tasks = tasks;
+
+        std::lock_guard serial(m_serial);
+        scope_t scope(this);
+
+        {
+            std::unique_lock lock(m_mutex);
+
+            // A worker that joined the previous job late may still be
+            // draining its (empty) share of it.
+            m_idle.wait(lock, [this] { return m_active == 0; });
+
+            m_job = job;
+            m_next = 0;
+            ++m_generation;
+        }
+
+        m_wakeup.notify_all();
+        execute(job);
+
+        std::exception_ptr error;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_idle.wait(lock, [this] { return m_active == 0; });
+
+            error = std::exchange(m_error, nullptr);
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    // Marks the pool a thread is running tasks for, so nested calls run inline.
+    class scope_t
+    {
+    public:
+        explicit scope_t(const parallel_pool_t* pool) noexcept
+            : m_previous(std::exchange(current(), pool))
+        {}
+
+        scope_t(const scope_t& /* that */) = delete;
+        scope_t(scope_t&& /* that */) = delete;
+
+        ~scope_t()
+        {
+            current() = m_previous;
+        }
+
+        scope_t& operator=(const scope_t& /* that */) = delete;
+        scope_t& operator=(scope_t&& /* that */) = delete;
+
+    private:
+        const parallel_pool_t* m_previous;
+    };
+
+    static const parallel_pool_t*& current() noexcept
+    {
+        thread_local const parallel_pool_t* pool = nullptr;
+        return pool;
+    }
+
+    void work(const std::stop_token& token)
+    {
+        scope_t scope(this);
+        std::uint64_t seen = 0;
+
+        while (true)
+        {
+            job_t job;
+
+            {
+                std::unique_lock lock(m_mutex);
+
+                if (!m_wakeup.wait(lock, token, [this, seen] { return m_generation != seen; }))
+                {
+                    return;
+                }
+
+                seen = m_generation;
+                job = m_job;
+                ++m_active;
+            }
+
+            execute(job);
+
+            std::unique_lock lock(m_mutex);
+
+            if (--m_active == 0)
+            {
+                m_idle.notify_all();
+            }
+        }
+    }
+
+    // The counter is reset only while no worker is active, so a task index
+    // is never taken twice and a stale job is never called after run()
+    // returned. Exceptions never leave: a worker would terminate, and the
+    // caller would unwind the task function while workers still call it.
+    void execute(const job_t& job) noexcept
+    {
+        while (true)
+        {
+            auto task = m_next.fetch_add(1, std::memory_order_relaxed);
+
+            if (task >= job.tasks)
+            {
+                return;
+            }
+
+            try
+            {
+                job.invoke(job.context, task);
+            }
+            catch (...)
+            {
+                {
+                    std::lock_guard lock(m_mutex);
+
+                    if (!m_error)
+                    {
+                        m_error = std::current_exception();
+                    }
+                }
+
+                // Tasks already running finish; the rest are skipped.
+                m_next.store(job.tasks, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    static std::vector<int> allowed_cpus()
+    {
+        std::vector<int> cpus;
+
+#if defined(__linux__)
+        cpu_set_t set{};
+
+        if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(static_cast<std::size_t>(cpu), &set))
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+
+        if (cpus.empty())
+        {
+            cpus.resize(std::max(1U, std::thread::hardware_concurrency()));
+            std::iota(cpus.begin(), cpus.end(), 0);
+        }
+
+        return cpus;
+    }
+
+    std::mutex m_serial;
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_wakeup;
+    std::condition_variable m_idle;
+
+    job_t m_job;
+    std::uint64_t m_generation = 0;
+    std::size_t m_active = 0;
+    std::atomic<std::size_t> m_next{0};
+
+    // First exception of the current job, guarded by m_mutex.
+    std::exception_ptr m_error;
+
+    // Last, so the workers are stopped before the state they use goes away.
+    std::vector<thread_t> m_workers;
+};
+
+/*****************************************************************************/
+/*** FREE FUNCTIONS **********************************************************/
+
+struct parallel_options_t
+{
+    // Items per task; 0 picks one (see grain()).
+    std::size_t grain = 0;
+
+    // Partial results are always combined left to right; this also makes
+    // the block boundaries depend only on the input size and grain, never on
+    // the pool size, so a floating point reduction or scan gives
+    // bit-identical results on any machine.
+    bool deterministic = false;
+
+    parallel_pool_t* pool = nullptr;
+};
+
+namespace parallel
+{
+    // Below this many items per task, handing out the task costs more than
+    // the loop body for anything but heavy bodies; set grain explicitly then.
+    inline constexpr std::size_t minimum_grain = 2048;
+
+    // Task size used in deterministic mode when none is given.
+    inline constexpr std::size_t deterministic_grain = 16384;
+
+    [[nodiscard]] inline parallel_pool_t& pool_of(const parallel_options_t& options)
+    {
+        return options.pool ? *options.pool : parallel_pool_t::shared();
+    }
+
+    // Four tasks per thread balance uneven bodies without making tasks
+    // too small to pay for their dispatch.
+    [[nodiscard]] inline std::size_t grain(std::size_t count, std::size_t threads, const parallel_options_t& options) noexcept
+    {
+        if (options.grain != 0)
+        {
+            return options.grain;
+        }
+
+        if (options.deterministic)
+        {
+            return deterministic_grain;
+        }
+
+        return std::max(minimum_grain, (count + threads * 4 - 1) / (threads * 4));
+    }
+
+    // Calls fn(begin, end) for consecutive blocks of [first, last).
+    template <typename F>
+    void blocks(std::size_t first, std::size_t last, const parallel_options_t& options, F&& fn)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+
+        auto& pool = pool_of(options);
+        auto count = last - first;
+        auto size = grain(count, pool.size(), options);
+        auto tasks = (count + size - 1) / size;
+
+        pool.run(tasks, [&](std::size_t task) {
+            auto begin = first + task * size;
+            fn(task, begin, std::min(last, begin + size));
+        });
+    }
+}  // namespace parallel
+
+// Calls fn(i) for every i in [first, last).
+template <typename F>
+void parallel_for(std::size_t first, std::size_t last, F&& fn, const parallel_options_t& options = {})
+{
+    parallel::blocks(first, last, options, [&fn](std::size_t /* task */, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i)
+        {
+            fn(i);
+        }
+    });
+}
+
+// Calls fn(item) for every item.
+template <typename T, std::size_t Extent, typename F>
+void parallel_for(std::span<T, Extent> items, F&& fn, const parallel_options_t& options = {})
+{
+    parallel_for(
+        0,
+        items.size(),
+        [&items, &fn](std::size_t i) { fn(items[i]); },
+        options);
+}
+
+// init op map(first) op ... op map(last - 1). op must be associative; the
+// order of operands is kept, so it need not be commutative.
+template <typename R, typename Map, typename Op>
+[[nodiscard]] R parallel_reduce(std::size_t first, std::size_t last, R init, Map&& map, Op&& op, const parallel_options_t& options = {})
+{
+    if (first >= last)
+    {
+        return init;
+    }
+
+    auto& pool = parallel::pool_of(options);
+    auto count = last - first;
+    auto size = parallel::grain(count, pool.size(), options);
+
+    std::vector<std::optional<R>> partials((count + size - 1) / size);
+
+    parallel::blocks(first, last, options, [&](std::size_t task, std::size_t begin, std::size_t end) {
+        R partial = map(begin);
+
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            partial = op(std::move(partial), map(i));
+        }
+
+        partials[task].emplace(std::move(partial));
+    });
+
+    for (auto& partial : partials)
+    {
+        init = op(std::move(init), std::move(*partial));
+    }
+
+    return init;
+}
+
+template <typename T, std::size_t Extent, typename R, typename Op>
+[[nodiscard]] R parallel_reduce(std::span<T, Extent> items, R init, Op&& op, const parallel_options_t& options = {})
+{
+    return parallel_reduce(
+        0,
+        items.size(),
+        std::move(init),
+        [&items](std::size_t i) -> R { return items[i]; },
+        std::forward<Op>(op),
+        options);
+}
+
+// output[i] = input[0] op ... op input[i]. output may be input itself. Two
+// passes: block totals, then each block rescanned from the prefix of the
+// totals before it.
+template <typename T, std::size_t InputExtent, typename U, std::size_t OutputExtent, typename Op>
+void parallel_inclusive_scan(std::span<T, InputExtent> input, std::span<U, OutputExtent> output, Op&& op, const parallel_options_t& options = {})
+{
+    using value_t = std::remove_cv_t<U>;
+
+    auto count = std::min(input.size(), output.size());
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    auto& pool = parallel::pool_of(options);
+    auto size = parallel::grain(count, pool.size(), options);
+    auto tasks = (count + size - 1) / size;
+
+    if (tasks == 1)
+    {
+        value_t running = input[0];
+        output[0] = running;
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            running = op(std::move(running), input[i]);
+            output[i] = running;
+        }
+
+        return;
+    }
+
+    std::vector<std::optional<value_t>> totals(tasks);
+
+    parallel::blocks(0, count, options, [&](std::size_t task, std::size_t begin, std::size_t end) {
+        value_t total = input[begin];
+
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            total = op(std::move(total), input[i]);
+        }
+
+        totals[task].emplace(std::move(total));
+    });
+
+    // Running totals of the blocks, serially: there are few.
+    for (std::size_t task = 1; task < tasks; ++task)
+    {
+        *totals[task] = op(*totals[task - 1], std::move(*totals[task]));
+    }
+
+    parallel::blocks(0, count, options, [&](std::size_t task, std::size_t begin, std::size_t end) {
+        value_t running = task == 0 ? value_t(input[begin]) : op(*totals[task - 1], input[begin]);
+        output[begin] = running;
+
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            running = op(std::move(running), input[i]);
+            output[i] = running;
+        }
+    });
+}
+
+#endif  // PARALLEL_HPP
@@ -0,0 +1,238 @@
+#ifndef PER_THREAD_HPP
+#define PER_THREAD_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CONSTANTS ***************************************************************/
+
+namespace utils
+{
+#if defined(__cpp_lib_hardware_interference_size)
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Winterference-size"
+    #endif
+
+    // The value may differ between compiler versions and -mtune settings;
+    // it only sizes padding here and never crosses an ABI boundary.
+    inline constexpr std::size_t false_sharing_size = std::hardware_destructive_interference_size;
+
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+#else
+    inline constexpr std::size_t false_sharing_size = cache_line_size;
+#endif
+}  // namespace utils
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Dense indices for live threads. A thread takes the lowest free index on
+// first use (thread_t does so as the thread starts) and returns it on exit,
+// so the index range stays as small as the peak thread count.
+class thread_registry
+{
+public:
+    static constexpr std::size_t max_threads = 1024;
+    static constexpr std::size_t npos = max_threads;
+
+    // The calling thread's index, or npos once max_threads threads hold one.
+    static std::size_t index()
+    {
+        thread_local slot_t slot;
+        return slot.index();
+    }
+
+    // Threads currently holding an index.
+    static std::size_t size() noexcept
+    {
+        return instance().m_live.load(std::memory_order_relaxed);
+    }
+
+    // One past the highest index ever handed out.
+    static std::size_t extent() noexcept
+    {
+        return instance().m_next.load(std::memory_order_acquire);
+    }
+
+private:
+    class slot_t
+    {
+    public:
+        slot_t()
+        {
+            auto& registry = instance();
+            std::lock_guard lock(registry.m_mutex);
+
+            if (!registry.m_free.empty())
+            {
+                m_index = registry.m_free.back();
+                registry.m_free.pop_back();
+            }
+            else if (auto next = registry.m_next.load(std::memory_order_relaxed); next < max_threads)
+            {
+                m_index = next;
+                registry.m_next.store(next + 1, std::memory_order_release);
+            }
+
+            if (m_index != npos)
+            {
+                registry.m_live.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        slot_t(const slot_t& /* that */) = delete;
+        slot_t(slot_t&& /* that */) = delete;
+
+        ~slot_t()
+        {
+            if (m_index == npos)
+            {
+                return;
+            }
+
+            auto& registry = instance();
+            std::lock_guard lock(registry.m_mutex);
+
+            // Lowest index first keeps per_thread_t enumeration short.
+            registry.m_free.insert(std::upper_bound(registry.m_free.begin(), registry.m_free.end(), m_index, std::greater<>()), m_index);
+            registry.m_live.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        slot_t& operator=(const slot_t& /* that */) = delete;
+        slot_t& operator=(slot_t&& /* that */) = delete;
+
+        [[nodiscard]] std::size_t index() const noexcept
+        {
+            return m_index;
+        }
+
+    private:
+        std::size_t m_index = npos;
+    };
+
+    thread_registry()
+    {
+        m_free.reserve(max_threads);
+    }
+
+    static thread_registry& instance()
+    {
+        static thread_registry instance;
+        return instance;
+    }
+
+    std::mutex m_mutex;
+
+    std::vector<std::size_t> m_free;
+    std::atomic<std::size_t> m_next{0};
+    std::atomic<std::size_t> m_live{0};
+};
+
+// One T per thread, each on cache lines of its own, so threads updating
+// their own slot never invalidate each other's. Slots are created on a
+// thread's first access and outlive it: the next thread given the same
+// registry index continues with the same value, which keeps sums intact.
+// Enumeration is lock-free; T must tolerate being read while its owner
+// writes (atomics, typically) if for_each runs concurrently.
+template <typename T>
+class per_thread_t
+{
+    struct alignas(utils::false_sharing_size) slot_t
+    {
+        T value{};
+    };
+
+public:
+    per_thread_t()
+        : m_slots(std::make_unique<std::array<std::atomic<slot_t*>, thread_registry::max_threads>>())
+    {}
+
+    per_thread_t(const per_thread_t& /* that */) = delete;
+    per_thread_t(per_thread_t&& /* that */) = delete;
+
+    ~per_thread_t()
+    {
+        for (auto& slot : *m_slots)
+        {
+            delete slot.load(std::memory_order_relaxed);
+        }
+    }
+
+    per_thread_t& operator=(const per_thread_t& /* that */) = delete;
+    per_thread_t& operator=(per_thread_t&& /* that */) = delete;
+
+    // Null when the registry is exhausted; callers then need a shared path.
+    [[nodiscard]] T* try_local()
+    {
+        auto index = thread_registry::index();
+
+        if (index == thread_registry::npos)
+        {
+            return nullptr;
+        }
+
+        // Only the owner of an index stores to its entry; the registry lock
+        // orders a previous owner's store before ours.
+        auto& entry = (*m_slots)[index];
+        auto* slot = entry.load(std::memory_order_relaxed);
+
+        if (!slot)
+        {
+            slot = new slot_t();
+            entry.store(slot, std::memory_order_release);
+        }
+
+        return std::addressof(slot->value);
+    }
+
+    [[nodiscard]] T& local()
+    {
+        auto* value = try_local();
+
+        if (!value)
+        {
+            panic("thread registry exhausted");
+        }
+
+        return *value;
+    }
+
+    // Visits every slot created so far, including those of exited threads.
+    template <typename F>
+    void for_each(F&& fn) const
+    {
+        auto extent = thread_registry::extent();
+
+        for (std::size_t i = 0; i < extent; ++i)
+        {
+            if (const auto* slot = (*m_slots)[i].load(std::memory_order_acquire))
+            {
+                fn(slot->value);
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<std::array<std::atomic<slot_t*>, thread_registry::max_threads>> m_slots;
+};
+
+#endif  // PER_THREAD_HPP
@@ -0,0 +1,477 @@
+#ifndef POOL_HPP
+#define POOL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "per_thread.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Fixed-size object pool. Every thread owns a free list inside the pool (a
+// per_thread_t slot) and only exchanges whole batches with the shared depot.
+// The depot is a fixed array of batch slots claimed with a single exchange,
+// so the common paths are lock-free and free of ABA; the mutex is only taken
+// to carve a new chunk or when the depot overflows.
+class pool_t
+{
+    static constexpr std::size_t batch_size = 32;
+    static constexpr std::size_t depot_slots = 64;
+
+    struct node_t
+    {
+        node_t* next;
+    };
+
+    // Written by the owning thread only, read by stats().
+    struct counters_t
+    {
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> refills{0};
+    };
+
+    struct cache_t
+    {
+        node_t* head = nullptr;
+        std::size_t count = 0;
+
+        counters_t counters;
+    };
+
+    struct chunk_t
+    {
+        void* memory;
+        std::size_t size;
+    };
+
+public:
+    static constexpr std::size_t default_chunk_length = 256;
+
+    struct stats_t
+    {
+        std::uint64_t allocations;
+
+        // Thread cache refills served by recycled batches.
+        std::uint64_t refills;
+
+        // Chunks taken from upstream and the objects carved from them.
+        std::uint64_t chunks;
+        std::uint64_t carved;
+
+        // Share of allocations served by recycled objects rather than fresh
+        // memory; approaches 1 once the pool has warmed up.
+        [[nodiscard]] double hit_rate() const noexcept
+        {
+            if (allocations == 0)
+            {
+                return 1.0;
+            }
+
+            return 1.0 - static_cast<double>(std::min(carved, allocations)) / static_cast<double>(allocations);
+        }
+    };
+
+    explicit pool_t(std::size_t object_size,
+                    std::size_t alignment = alignof(std::max_align_t),
+                    std::size_t chunk_length = default_chunk_length,
+                    std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_upstream(upstream)
+        , m_alignment(std::max(alignment, alignof(node_t)))
+        , m_stride(round_up(std::max(object_size, sizeof(node_t)), m_alignment))
+        , m_chunk_length(round_up(std::max(chunk_length, batch_size), batch_size))
+    {}
+
+    pool_t(const pool_t& /* that */) = delete;
+    pool_t(pool_t&& /* that */) = delete;
+
+    ~pool_t()
+    {
+        for (const auto& chunk : m_chunks)
+        {
+            m_upstream->deallocate(chunk.memory, chunk.size, m_alignment);
+        }
+    }
+
+    pool_t& operator=(const pool_t& /* that */) = delete;
+    pool_t& operator=(pool_t&& /* that */) = delete;
+
+    [[nodiscard]] void* allocate()
+    {
+        auto* cache = local();
+
+        if (!cache)
+        {
+            m_shared_allocations.fetch_add(1, std::memory_order_relaxed);
+
+            std::lock_guard lock(m_mutex);
+            return take_one();
+        }
+
+        bump(cache->counters.allocations);
+
+        if (!cache->head)
+        {
+            cache->head = acquire(cache->counters);
+            cache->count = batch_size;
+        }
+
+        auto* node = cache->head;
+
+        cache->head = node->next;
+        cache->count -= 1;
+
+        return node;
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        auto* node = static_cast<node_t*>(ptr);
+        auto* cache = local();
+
+        if (!cache)
+        {
+            std::lock_guard lock(m_mutex);
+            m_loose.push_back(::new (node) node_t{nullptr});
+            return;
+        }
+
+        ::new (node) node_t{cache->head};
+
+        cache->head = node;
+        cache->count += 1;
+
+        if (cache->count == 2 * batch_size)
+        {
+            release(*cache);
+        }
+    }
+
+    [[nodiscard]] std::size_t object_size() const noexcept
+    {
+        return m_stride;
+    }
+
+    [[nodiscard]] std::size_t alignment() const noexcept
+    {
+        return m_alignment;
+    }
+
+    [[nodiscard]] stats_t stats() const
+    {
+        stats_t stats{};
+
+        stats.allocations = m_shared_allocations.load(std::memory_order_relaxed);
+        stats.chunks = m_carved_chunks.load(std::memory_order_relaxed);
+        stats.carved = stats.chunks * m_chunk_length;
+
+        m_caches.for_each([&stats](const cache_t& cache) {
+            stats.allocations += cache.counters.allocations.load(std::memory_order_relaxed);
+            stats.refills += cache.counters.refills.load(std::memory_order_relaxed);
+        });
+
+        return stats;
+    }
+
+private:
+    static std::size_t round_up(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static void bump(std::atomic<std::uint64_t>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Null once the thread registry is exhausted; such threads go through
+    // the mutex for every object.
+    cache_t* local()
+    {
+        return m_caches.try_local();
+    }
+
+    // Threads start probing on different cache lines of the depot.
+    static std::size_t first_slot()
+    {
+        return thread_registry::index() * (utils::cache_line_size / sizeof(void*));
+    }
+
+    // Returns a full batch, recycled when possible.
+    node_t* acquire(counters_t& counters)
+    {
+        auto start = first_slot();
+
+        for (std::size_t i = 0; i < depot_slots; ++i)
+        {
+            auto& slot = m_depot[(start + i) % depot_slots];
+
+            if (slot.load(std::memory_order_relaxed))
+            {
+                if (auto* batch = slot.exchange(nullptr, std::memory_order_acquire))
+                {
+                    bump(counters.refills);
+                    return batch;
+                }
+            }
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        if (!m_overflow.empty())
+        {
+            auto* batch = m_overflow.back();
+            m_overflow.pop_back();
+
+            bump(counters.refills);
+            return batch;
+        }
+
+        return carve();
+    }
+
+    void release(cache_t& cache)
+    {
+        auto* tail = cache.head;
+
+        for (std::size_t i = 1; i < batch_size; ++i)
+        {
+            tail = tail->next;
+        }
+
+        auto* batch = cache.head;
+
+        cache.head = tail->next;
+        cache.count -= batch_size;
+
+        tail->next = nullptr;
+        publish(batch);
+    }
+
+    void publish(node_t* batch)
+    {
+        if (!try_publish(batch))
+        {
+            std::lock_guard lock(m_mutex);
+            m_overflow.push_back(batch);
+        }
+    }
+
+    bool try_publish(node_t* batch)
+    {
+        auto start = first_slot();
+
+        for (std::size_t i = 0; i < depot_slots; ++i)
+        {
+            auto& slot = m_depot[(start + i) % depot_slots];
+            node_t* expected = nullptr;
+
+            if (!slot.load(std::memory_order_relaxed) && slot.compare_exchange_strong(expected, batch, std::memory_order_release, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Mutex held.
+    void* take_one()
+    {
+        if (m_loose.empty())
+        {
+            node_t* batch = nullptr;
+
+            if (m_overflow.empty())
+            {
+                batch = carve();
+            }
+            else
+            {
+                batch = m_overflow.back();
+                m_overflow.pop_back();
+            }
+
+            for (auto* node = batch; node; node = node->next)
+            {
+                m_loose.push_back(node);
+            }
+        }
+
+        auto* node = m_loose.back();
+        m_loose.pop_back();
+
+        return node;
+    }
+
+    // Mutex held. Returns one batch and publishes the rest of the chunk.
+    node_t* carve()
+    {
+        auto size = m_stride * m_chunk_length;
+        auto* memory = static_cast<std::byte*>(m_upstream->allocate(size, m_alignment));
+
+        m_chunks.push_back(chunk_t{memory, size});
+        m_carved_chunks.fetch_add(1, std::memory_order_relaxed);
+
+        node_t* first = nullptr;
+
+        for (std::size_t start = 0; start < m_chunk_length; start += batch_size)
+        {
+            node_t* head = nullptr;
+
+            for (auto i = start + batch_size; i > start; --i)
+            {
+                head = ::new (memory + (i - 1) * m_stride) node_t{head};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            if (!first)
+            {
+                first = head;
+            }
+            else if (!try_publish(head))
+            {
+                m_overflow.push_back(head);
+            }
+        }
+
+        return first;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+
+    std::size_t m_alignment;
+    std::size_t m_stride;
+    std::size_t m_chunk_length;
+
+    per_thread_t<cache_t> m_caches;
+    std::array<std::atomic<node_t*>, depot_slots> m_depot{};
+
+    std::mutex m_mutex;
+    std::vector<node_t*> m_overflow;
+    std::vector<node_t*> m_loose;
+    std::vector<chunk_t> m_chunks;
+
+    std::atomic<std::uint64_t> m_shared_allocations{0};
+    std::atomic<std::uint64_t> m_carved_chunks{0};
+};
+
+class pool_resource_t : public std::pmr::memory_resource
+{
+public:
+    explicit pool_resource_t(std::size_t object_size,
+                             std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_pool(object_size, alignof(std::max_align_t), pool_t::default_chunk_length, upstream)
+        , m_upstream(upstream)
+    {}
+
+    [[nodiscard]] pool_t& pool() noexcept
+    {
+        return m_pool;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (bytes <= m_pool.object_size() && alignment <= m_pool.alignment())
+        {
+            return m_pool.allocate();
+        }
+
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        if (bytes <= m_pool.object_size() && alignment <= m_pool.alignment())
+        {
+            m_pool.deallocate(ptr);
+            return;
+        }
+
+        m_upstream->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override
+    {
+        return this == std::addressof(that);
+    }
+
+    pool_t m_pool;
+    std::pmr::memory_resource* m_upstream;
+};
+
+// Typed front end for objects that come and go at a high rate, such as
+// per-connection state or accepted sockets. Objects are constructed in
+// recycled storage and handed out as a unique_ptr that destroys them and
+// returns the storage to the calling thread's cache.
+template <typename T>
+class object_pool_t
+{
+public:
+    class deleter_t
+    {
+    public:
+        deleter_t() = default;
+
+        void operator()(T* object) const noexcept
+        {
+            object->~T();
+            m_pool->deallocate(object);
+        }
+
+    private:
+        friend class object_pool_t;
+
+        explicit deleter_t(pool_t* pool) noexcept
+            : m_pool(pool)
+        {}
+
+        pool_t* m_pool = nullptr;
+    };
+
+    using handle_t = std::unique_ptr<T, deleter_t>;
+
+    explicit object_pool_t(std::size_t chunk_length = pool_t::default_chunk_length,
+                           std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : m_pool(sizeof(T), alignof(T), chunk_length, upstream)
+    {}
+
+    template <typename... Args>
+    [[nodiscard]] handle_t make(Args&&... args)
+    {
+        // Hands the storage back if the constructor throws.
+        auto release = [this](void* memory) { m_pool.deallocate(memory); };
+        std::unique_ptr<void, decltype(release)> memory(m_pool.allocate(), release);
+
+        auto* object = ::new (memory.get()) T(std::forward<Args>(args)...);
+        std::ignore = memory.release();
+
+        return handle_t(object, deleter_t(std::addressof(m_pool)));
+    }
+
+    [[nodiscard]] pool_t::stats_t stats() const
+    {
+        return m_pool.stats();
+    }
+
+private:
+    pool_t m_pool;
+};
+
+#endif  // POOL_HPP
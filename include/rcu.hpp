@@ -0,0 +1,283 @@
+#ifndef RCU_HPP
+#define RCU_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "per_thread.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Epoch-based reclamation. A reader announces the global epoch in its own
+// per_thread_t slot for the length of a critical section; nothing shared is
+// written. Writers unlink an object, retire it under the next epoch and free
+// it once no reader is still inside an older epoch.
+class epoch_domain_t
+{
+    struct reader_slot_t
+    {
+        // Zero while the thread is outside any critical section.
+        std::atomic<std::uint64_t> epoch{0};
+        std::size_t depth = 0;
+    };
+
+    struct retired_t
+    {
+        void* object;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+public:
+    // Critical section; nests. Pointers read inside stay valid until it ends.
+    class guard_t
+    {
+    public:
+        guard_t(const guard_t& /* that */) = delete;
+        guard_t(guard_t&& /* that */) = delete;
+
+        ~guard_t()
+        {
+            if (--m_reader.depth == 0)
+            {
+                m_reader.epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        guard_t& operator=(const guard_t& /* that */) = delete;
+        guard_t& operator=(guard_t&& /* that */) = delete;
+
+    private:
+        friend class epoch_domain_t;
+
+        explicit guard_t(reader_slot_t& reader) noexcept
+            : m_reader(reader)
+        {}
+
+        reader_slot_t& m_reader;
+    };
+
+    epoch_domain_t() = default;
+
+    epoch_domain_t(const epoch_domain_t& /* that */) = delete;
+    epoch_domain_t(epoch_domain_t&& /* that */) = delete;
+
+    // No reader may still be inside a critical section.
+    ~epoch_domain_t()
+    {
+        for (const auto& item : m_retired)
+        {
+            item.deleter(item.object);
+        }
+    }
+
+    epoch_domain_t& operator=(const epoch_domain_t& /* that */) = delete;
+    epoch_domain_t& operator=(epoch_domain_t&& /* that */) = delete;
+
+    [[nodiscard]] guard_t enter()
+    {
+        auto& reader = m_readers.local();
+
+        if (reader.depth++ == 0)
+        {
+            reader.epoch.store(m_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+            // Pairs with the fence in retire(): either the writer sees this
+            // announcement or the loads that follow see the unlinked state.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        return guard_t(reader);
+    }
+
+    // Call after object is unreachable for new readers.
+    template <typename T>
+    void retire(T* object)
+    {
+        retire(object, [](void* pointer) { delete static_cast<T*>(pointer); });
+    }
+
+    void retire(void* object, void (*deleter)(void*))
+    {
+        auto epoch = m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::lock_guard lock(m_mutex);
+
+        m_retired.push_back(retired_t{object, deleter, epoch});
+        collect();
+    }
+
+    // Frees whatever no reader can reach any more; returns what is left.
+    std::size_t reclaim()
+    {
+        std::lock_guard lock(m_mutex);
+        collect();
+
+        return m_retired.size();
+    }
+
+    // Blocks until everything retired so far is freed. Must not be called
+    // from inside a critical section.
+    void synchronize()
+    {
+        while (reclaim() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    [[nodiscard]] std::uint64_t oldest_reader() const
+    {
+        auto oldest = std::numeric_limits<std::uint64_t>::max();
+
+        m_readers.for_each([&oldest](const reader_slot_t& reader) {
+            if (auto epoch = reader.epoch.load(std::memory_order_acquire); epoch != 0)
+            {
+                oldest = std::min(oldest, epoch);
+            }
+        });
+
+        return oldest;
+    }
+
+    void collect()
+    {
+        auto oldest = oldest_reader();
+
+        // Readers that announced a later epoch loaded the pointer after it
+        // was unlinked.
+        std::erase_if(m_retired, [oldest](const retired_t& item) {
+            if (item.epoch >= oldest)
+            {
+                return false;
+            }
+
+            item.deleter(item.object);
+            return true;
+        });
+    }
+
+    std::atomic<std::uint64_t> m_epoch{1};
+    per_thread_t<reader_slot_t> m_readers;
+
+    std::mutex m_mutex;
+    std::vector<retired_t> m_retired;
+};
+
+// Read-mostly shared object, e.g. configuration or a routing table. Readers
+// take a snapshot without locking or writing shared memory; writers publish
+// a new version and the old one is freed once its last reader is done.
+template <typename T>
+class rcu_t
+{
+public:
+    class reader_t
+    {
+    public:
+        [[nodiscard]] const T& operator*() const noexcept
+        {
+            return *m_object;
+        }
+
+        [[nodiscard]] const T* operator->() const noexcept
+        {
+            return m_object;
+        }
+
+        [[nodiscard]] const T* get() const noexcept
+        {
+            return m_object;
+        }
+
+    private:
+        friend class rcu_t;
+
+        reader_t(epoch_domain_t& domain, const std::atomic<const T*>& current)
+            : m_guard(domain.enter())
+            , m_object(current.load(std::memory_order_acquire))
+        {}
+
+        epoch_domain_t::guard_t m_guard;
+        const T* m_object;
+    };
+
+    rcu_t()
+        : rcu_t(std::make_unique<T>())
+    {}
+
+    explicit rcu_t(std::unique_ptr<T> object)
+        : m_current(object.release())
+    {}
+
+    rcu_t(const rcu_t& /* that */) = delete;
+    rcu_t(rcu_t&& /* that */) = delete;
+
+    ~rcu_t()
+    {
+        delete m_current.load(std::memory_order_relaxed);
+    }
+
+    rcu_t& operator=(const rcu_t& /* that */) = delete;
+    rcu_t& operator=(rcu_t&& /* that */) = delete;
+
+    // Keep the reader short-lived: it holds back reclamation.
+    [[nodiscard]] reader_t read() const
+    {
+        return reader_t(m_domain, m_current);
+    }
+
+    void store(std::unique_ptr<T> object)
+    {
+        std::lock_guard lock(m_writer);
+        publish(std::move(object));
+    }
+
+    // Copy, change and publish, serialized with other writers.
+    template <typename F>
+    void update(F&& fn)
+    {
+        std::lock_guard lock(m_writer);
+
+        auto object = std::make_unique<T>(*m_current.load(std::memory_order_relaxed));
+        fn(*object);
+
+        publish(std::move(object));
+    }
+
+    void synchronize()
+    {
+        m_domain.synchronize();
+    }
+
+private:
+    void publish(std::unique_ptr<T> object)
+    {
+        const auto* previous = m_current.exchange(object.release(), std::memory_order_acq_rel);
+        m_domain.retire(const_cast<T*>(previous));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+
+    mutable epoch_domain_t m_domain;
+    std::atomic<const T*> m_current;
+
+    std::mutex m_writer;
+};
+
+#endif  // RCU_HPP
@@ -0,0 +1,223 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+    #include <sys/eventfd.h>
+#endif  // __linux__
+
+#include "mpsc_queue.hpp"
+
+/// \cond
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Single-threaded poll loop. Descriptors and their handlers are only touched
+// on the loop thread; other threads hand work over with post(), which is
+// lock-free and wakes the loop through an eventfd (a pipe elsewhere) only
+// when the task queue goes from empty to non-empty.
+class reactor_t
+{
+public:
+    using handler_t = std::function<void(short events)>;
+    using task_t = std::function<void()>;
+
+    reactor_t()
+    {
+#if defined(__linux__)
+        m_wakeup[0] = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        m_wakeup[1] = m_wakeup[0];
+#else
+        if (::pipe(m_wakeup.data()) == 0)
+        {
+            for (auto descriptor : m_wakeup)
+            {
+                ::fcntl(descriptor, F_SETFL, ::fcntl(descriptor, F_GETFL, 0) | O_NONBLOCK);
+                ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+            }
+        }
+#endif
+    }
+
+    reactor_t(const reactor_t& /* that */) = delete;
+    reactor_t(reactor_t&& /* that */) = delete;
+
+    ~reactor_t()
+    {
+        ::close(m_wakeup[0]);
+
+        if (m_wakeup[1] != m_wakeup[0])
+        {
+            ::close(m_wakeup[1]);
+        }
+    }
+
+    reactor_t& operator=(const reactor_t& /* that */) = delete;
+    reactor_t& operator=(reactor_t&& /* that */) = delete;
+
+    // Loop thread only (or before run()). Handlers may add and remove
+    // descriptors, including their own, while they run.
+    void add(int descriptor, short events, handler_t handler)
+    {
+        m_entries[descriptor] = entry_t{events, std::make_shared<handler_t>(std::move(handler))};
+    }
+
+    void remove(int descriptor)
+    {
+        m_entries.erase(descriptor);
+    }
+
+    [[nodiscard]] bool watching(int descriptor) const
+    {
+        return m_entries.contains(descriptor);
+    }
+
+    // Any thread.
+    void post(task_t task)
+    {
+        if (m_tasks.push(std::move(task)))
+        {
+            wake();
+        }
+    }
+
+    // Ends the current run(), or the next one if the loop is not running
+    // yet, so a stop() racing with startup is not lost. Each stop ends
+    // exactly one run().
+    void stop()
+    {
+        m_stop_requested.store(true, std::memory_order_relaxed);
+        wake();
+    }
+
+    [[nodiscard]] bool in_loop() const noexcept
+    {
+        return m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    void run()
+    {
+        while (!m_stop_requested.exchange(false, std::memory_order_relaxed))
+        {
+            std::ignore = run_once(-1);
+        }
+    }
+
+    // Runs until stop() or until token is stopped, e.g. by the thread_t that
+    // owns this loop: the stop wakes the loop through the same eventfd as
+    // post(), so a loop blocked in poll() returns at once.
+    void run(std::stop_token token)
+    {
+        std::stop_callback wake_on_stop(token, [this] { wake(); });
+
+        while (!token.stop_requested() && !m_stop_requested.exchange(false, std::memory_order_relaxed))
+        {
+            std::ignore = run_once(-1);
+        }
+    }
+
+    // Waits up to timeout milliseconds (-1 for ever) and dispatches whatever
+    // became ready. Returns the number of handlers and tasks run.
+    [[nodiscard]] std::size_t run_once(int timeout)
+    {
+        m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        m_polled.clear();
+        m_polled.push_back(pollfd{m_wakeup[0], POLLIN, 0});
+
+        for (const auto& [descriptor, entry] : m_entries)
+        {
+            m_polled.push_back(pollfd{descriptor, entry.events, 0});
+        }
+
+        if (!m_tasks.empty())
+        {
+            timeout = 0;
+        }
+
+        if (::poll(m_polled.data(), m_polled.size(), timeout) < 0)
+        {
+            return 0;
+        }
+
+        std::size_t count = 0;
+
+        if (m_polled.front().revents != 0)
+        {
+            std::uint64_t value = 0;
+
+            while (::read(m_wakeup[0], &value, sizeof(value)) > 0)
+            {
+            }
+        }
+
+        for (std::size_t i = 1; i < m_polled.size(); ++i)
+        {
+            auto [descriptor, events, revents] = m_polled[i];
+
+            if (revents == 0)
+            {
+                continue;
+            }
+
+            // Keep the handler alive even if it removes or replaces itself.
+            auto found = m_entries.find(descriptor);
+
+            if (found != m_entries.end())
+            {
+                auto handler = found->second.handler;
+                (*handler)(revents);
+
+                count += 1;
+            }
+        }
+
+        return count + m_tasks.drain([](task_t&& task) { task(); });
+    }
+
+private:
+    struct entry_t
+    {
+        short events;
+        std::shared_ptr<handler_t> handler;
+    };
+
+    void wake() noexcept
+    {
+        std::uint64_t value = 1;
+        std::ignore = ::write(m_wakeup[1], &value, sizeof(value));
+    }
+
+    std::array<int, 2> m_wakeup{-1, -1};
+
+    std::unordered_map<int, entry_t> m_entries;
+    std::vector<pollfd> m_polled;
+
+    mpsc_queue_t<task_t> m_tasks;
+
+    std::atomic<bool> m_stop_requested{false};
+    std::atomic<std::thread::id> m_owner;
+};
+
+#endif  // REACTOR_HPP
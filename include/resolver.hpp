@@ -0,0 +1,255 @@
+#ifndef RESOLVER_HPP
+#define RESOLVER_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#if defined(_WIN32)
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <netdb.h>
+    #include <sys/socket.h>
+#endif
+
+#include "endpoint.hpp"
+#include "thread.hpp"
+
+/// \cond
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Host name cache filled by getaddrinfo on a worker thread. Lookups never
+// block: an expired entry is still returned while a refresh is queued, so a
+// reconnect path only waits for the very first resolution of a host. A
+// failed resolution is retried after the shorter negative TTL, so a
+// transient DNS error does not stick for the whole TTL.
+class resolver_t
+{
+public:
+    using callback_t = std::function<void(std::optional<endpoint_t>)>;
+
+private:
+    using clock_t = std::chrono::steady_clock;
+
+    struct entry_t
+    {
+        std::vector<endpoint_t> endpoints;
+        clock_t::time_point expiry;
+
+        bool refreshing = false;
+        std::vector<std::pair<uint16_t, callback_t>> waiters;
+    };
+
+public:
+    explicit resolver_t(std::chrono::milliseconds ttl = std::chrono::seconds(60), std::chrono::milliseconds negative_ttl = std::chrono::seconds(5))
+        : m_ttl(ttl)
+        , m_negative_ttl(negative_ttl)
+        , m_worker([this] { run(); })
+    {
+        std::ignore = m_worker.set_name("resolver");
+    }
+
+    resolver_t(const resolver_t& /* that */) = delete;
+    resolver_t(resolver_t&& /* that */) = delete;
+
+    // Callbacks still waiting for an answer get std::nullopt.
+    ~resolver_t()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_running = false;
+        }
+
+        m_wakeup.notify_all();
+        m_worker.join();
+
+        for (auto& [host, entry] : m_cache)
+        {
+            for (auto& [port, callback] : entry.waiters)
+            {
+                callback(std::nullopt);
+            }
+        }
+    }
+
+    resolver_t& operator=(const resolver_t& /* that */) = delete;
+    resolver_t& operator=(resolver_t&& /* that */) = delete;
+
+    [[nodiscard]] std::optional<endpoint_t> lookup(std::string_view host, uint16_t port)
+    {
+        if (auto endpoint = endpoint_t::parse(host, port))
+        {
+            return endpoint;
+        }
+
+        std::lock_guard lock(m_mutex);
+        auto& entry = m_cache[std::string(host)];
+
+        if (clock_t::now() >= entry.expiry)
+        {
+            schedule(host, entry);
+        }
+
+        return select(entry, port);
+    }
+
+    void resolve(std::string_view host, uint16_t port, callback_t callback)
+    {
+        if (auto endpoint = endpoint_t::parse(host, port))
+        {
+            callback(endpoint);
+            return;
+        }
+
+        std::unique_lock lock(m_mutex);
+        auto& entry = m_cache[std::string(host)];
+
+        if (clock_t::now() < entry.expiry)
+        {
+            auto endpoint = select(entry, port);
+            lock.unlock();
+
+            callback(endpoint);
+            return;
+        }
+
+        entry.waiters.emplace_back(port, std::move(callback));
+        schedule(host, entry);
+    }
+
+    void flush()
+    {
+        std::lock_guard lock(m_mutex);
+        std::erase_if(m_cache, [](const auto& item) { return !item.second.refreshing; });
+    }
+
+private:
+    static std::optional<endpoint_t> select(const entry_t& entry, uint16_t port)
+    {
+        if (entry.endpoints.empty())
+        {
+            return std::nullopt;
+        }
+
+        auto endpoint = entry.endpoints.front();
+        endpoint.set_port(port);
+
+        return endpoint;
+    }
+
+    void schedule(std::string_view host, entry_t& entry)
+    {
+        if (entry.refreshing)
+        {
+            return;
+        }
+
+        entry.refreshing = true;
+        m_queue.emplace_back(host);
+
+        m_wakeup.notify_one();
+    }
+
+    static std::vector<endpoint_t> query(const std::string& host)
+    {
+        addrinfo hints{};
+
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_ADDRCONFIG;
+
+        addrinfo* result = nullptr;
+        std::vector<endpoint_t> endpoints;
+
+        if (::getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0)
+        {
+            return endpoints;
+        }
+
+        for (auto* item = result; item; item = item->ai_next)
+        {
+            endpoints.emplace_back(item->ai_addr, static_cast<std::size_t>(item->ai_addrlen));
+        }
+
+        ::freeaddrinfo(result);
+        return endpoints;
+    }
+
+    void run()
+    {
+        std::unique_lock lock(m_mutex);
+
+        while (true)
+        {
+            m_wakeup.wait(lock, [this] { return !m_running || !m_queue.empty(); });
+
+            if (!m_running)
+            {
+                return;
+            }
+
+            auto host = std::move(m_queue.front());
+            m_queue.pop_front();
+
+            lock.unlock();
+            auto endpoints = query(host);
+            lock.lock();
+
+            auto& entry = m_cache[host];
+            auto failed = endpoints.empty();
+
+            // Keep serving the previous answer when a refresh fails, but
+            // try again soon.
+            if (!failed || entry.endpoints.empty())
+            {
+                entry.endpoints = std::move(endpoints);
+            }
+
+            entry.expiry = clock_t::now() + (failed ? m_negative_ttl : m_ttl);
+            entry.refreshing = false;
+
+            auto waiters = std::exchange(entry.waiters, {});
+            auto answer = entry;
+
+            lock.unlock();
+
+            for (auto& [port, callback] : waiters)
+            {
+                callback(select(answer, port));
+            }
+
+            lock.lock();
+        }
+    }
+
+    std::chrono::milliseconds m_ttl;
+    std::chrono::milliseconds m_negative_ttl;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+
+    std::unordered_map<std::string, entry_t> m_cache;
+    std::deque<std::string> m_queue;
+
+    bool m_running = true;
+    thread_t m_worker;
+};
+
+#endif  // RESOLVER_HPP
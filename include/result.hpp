@@ -7,6 +7,7 @@
 #include "either.hpp"
 
 /// \cond
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -106,8 +107,8 @@ class result_t<Value, Error, std::enable_if_t<!std::is_void_v<Value>>>
 {
     using storage_type = either_t<Value, Error>;
 
-    static constexpr auto value = storage_type::left;
-    static constexpr auto error = storage_type::right;
+    static constexpr auto value_tag = storage_type::left;
+    static constexpr auto error_tag = storage_type::right;
 
 public:
     using value_type = Value;
@@ -115,13 +116,13 @@ public:
 
     // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
     constexpr result_t(success_t<value_type> item)
-        : m_storage(value, std::move(*item))
+        : m_storage(value_tag, std::move(*item))
         , m_has_value(true)
     {}
 
     // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
     constexpr result_t(fail_t<error_type> item)
-        : m_storage(error, std::move(*item))
+        : m_storage(error_tag, std::move(*item))
         , m_has_value(false)
     {}
 
@@ -133,11 +134,11 @@ public:
     {
         if (m_has_value)
         {
-            m_storage.destruct(value);
+            m_storage.destruct(value_tag);
         }
         else
         {
-            m_storage.destruct(error);
+            m_storage.destruct(error_tag);
         }
     }
 
@@ -154,6 +155,26 @@ public:
         return m_has_value;
     }
 
+    constexpr value_type& value() noexcept
+    {
+        return m_storage.get(value_tag);
+    }
+
+    [[nodiscard]] constexpr const value_type& value() const noexcept
+    {
+        return m_storage.get(value_tag);
+    }
+
+    constexpr error_type& error() noexcept
+    {
+        return m_storage.get(error_tag);
+    }
+
+    [[nodiscard]] constexpr const error_type& error() const noexcept
+    {
+        return m_storage.get(error_tag);
+    }
+
 private:
     storage_type m_storage;
     bool m_has_value;
@@ -164,7 +185,7 @@ class result_t<Value, Error, std::enable_if_t<std::is_void_v<Value>>>
 {
     using storage_type = either_t<Error>;
 
-    static constexpr auto error = storage_type::left;
+    static constexpr auto error_tag = storage_type::left;
 
 public:
     using value_type = Value;
@@ -182,7 +203,7 @@ public:
 
     // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
     constexpr result_t(fail_t<error_type> item)
-        : m_storage(error, std::move(*item))
+        : m_storage(error_tag, std::move(*item))
         , m_has_value(false)
     {}
 
@@ -194,7 +215,7 @@ public:
     {
         if (!m_has_value)
         {
-            m_storage.destruct(error);
+            m_storage.destruct(error_tag);
         }
     }
 
@@ -211,6 +232,16 @@ public:
         return m_has_value;
     }
 
+    constexpr error_type& error() noexcept
+    {
+        return m_storage.get(error_tag);
+    }
+
+    [[nodiscard]] constexpr const error_type& error() const noexcept
+    {
+        return m_storage.get(error_tag);
+    }
+
 private:
     storage_type m_storage;
     bool m_has_value;
@@ -222,6 +253,10 @@ success_t(T) -> success_t<T>;
 template <typename T>
 fail_t(T) -> fail_t<T>;
 
+// Outcome of a fallible system call: nothing on success, otherwise the errno
+// (or WSA) code captured as a std::error_code, which never allocates.
+using status_t = result_t<void, std::error_code>;
+
 #undef RESULT_CONSTEXPR_DESTRUCTOR
 
 #endif  // RESULT_HPP
@@ -0,0 +1,60 @@
+#ifndef SCAN_HPP
+#define SCAN_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+/// \cond
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string_view>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** FREE FUNCTIONS **********************************************************/
+
+// Byte scanning kernels for parsers. Each call goes through a table chosen
+// from CPUID on first use, so generic builds still get the widest vector
+// unit the host has.
+namespace scan
+{
+    using field_t = std::span<const std::byte>;
+
+    enum class isa_t
+    {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    [[nodiscard]] std::size_t find_byte(std::span<const std::byte> data, std::byte value) noexcept;
+    [[nodiscard]] std::size_t find_any(std::span<const std::byte> data, std::span<const std::byte> set) noexcept;
+    [[nodiscard]] std::size_t count_byte(std::span<const std::byte> data, std::byte value) noexcept;
+
+    // Splits data on delimiter into fields, without the delimiters. When the
+    // output runs out of room, the last field holds the unsplit remainder.
+    // Returns the number of fields written.
+    [[nodiscard]] std::size_t split(std::span<const std::byte> data, std::byte delimiter, std::span<field_t> fields) noexcept;
+
+    [[nodiscard]] isa_t active() noexcept;
+
+    // Switches every kernel to the given instruction set; intended for tests
+    // and benchmarks. Scans already running finish on the previous table.
+    [[nodiscard]] bool force(isa_t isa) noexcept;
+
+    [[nodiscard]] inline std::size_t count_newlines(std::span<const std::byte> data) noexcept
+    {
+        return count_byte(data, std::byte{'\n'});
+    }
+
+    [[nodiscard]] inline std::span<const std::byte> bytes(std::string_view text) noexcept
+    {
+        return std::as_bytes(std::span(text));
+    }
+}  // namespace scan
+
+#endif  // SCAN_HPP
@@ -0,0 +1,122 @@
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "utils.hpp"
+
+/// \cond
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Sequence lock for small trivially copyable snapshots. Readers copy the
+// value and retry if a write overlapped, so they never store to the shared
+// cache lines; writers are serialized by a mutex and never wait on readers.
+// The value is kept as relaxed atomic words, which makes the racy copy
+// well-defined.
+template <typename T>
+class seqlock_t
+{
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock_t needs a trivially copyable type");
+
+    using word_t = std::uint64_t;
+    static constexpr std::size_t words = (sizeof(T) + sizeof(word_t) - 1) / sizeof(word_t);
+
+public:
+    seqlock_t()
+        : seqlock_t(T{})
+    {}
+
+    explicit seqlock_t(const T& value)
+    {
+        write(value);
+    }
+
+    [[nodiscard]] T load() const noexcept
+    {
+        std::array<word_t, words> copy{};
+
+        while (true)
+        {
+            auto before = m_sequence.load(std::memory_order_acquire);
+
+            if ((before & 1) != 0)
+            {
+                cpu_relax();
+                continue;
+            }
+
+            for (std::size_t i = 0; i < words; ++i)
+            {
+                copy[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (m_sequence.load(std::memory_order_relaxed) == before)
+            {
+                break;
+            }
+        }
+
+        T value;
+        std::memcpy(&value, copy.data(), sizeof(T));
+
+        return value;
+    }
+
+    void store(const T& value)
+    {
+        std::lock_guard lock(m_mutex);
+        write(value);
+    }
+
+    // Read-modify-write under the writer lock: fn gets a copy to change.
+    template <typename F>
+    void update(F&& fn)
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto value = load();
+        fn(value);
+
+        write(value);
+    }
+
+private:
+    void write(const T& value) noexcept
+    {
+        std::array<word_t, words> copy{};
+        std::memcpy(copy.data(), &value, sizeof(T));
+
+        auto sequence = m_sequence.load(std::memory_order_relaxed);
+
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            m_words[i].store(copy[i], std::memory_order_relaxed);
+        }
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    alignas(utils::cache_line_size) std::atomic<std::uint64_t> m_sequence{0};
+    std::array<std::atomic<word_t>, words> m_words{};
+
+    std::mutex m_mutex;
+};
+
+#endif  // SEQLOCK_HPP
@@ -0,0 +1,575 @@
+#ifndef SHM_CHANNEL_HPP
+#define SHM_CHANNEL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+#endif  // __linux__
+
+#include "result.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Bidirectional byte stream between two processes over a POSIX shared memory
+// object. Each direction is a single-producer single-consumer ring; a side
+// that finds its ring empty (or full) spins for the busy-poll budget before
+// sleeping on a futex the peer only wakes while someone is waiting.
+class shm_channel_t
+{
+    static constexpr std::uint64_t magic = 0x746F6F6C626F7831;
+
+    struct alignas(utils::cache_line_size) ring_t
+    {
+        alignas(utils::cache_line_size) std::atomic<std::uint64_t> head;
+        alignas(utils::cache_line_size) std::atomic<std::uint64_t> tail;
+
+        alignas(utils::cache_line_size) std::atomic<std::uint32_t> readable;
+        std::atomic<std::uint32_t> reader_waiting;
+
+        alignas(utils::cache_line_size) std::atomic<std::uint32_t> writable;
+        std::atomic<std::uint32_t> writer_waiting;
+
+        std::atomic<std::uint32_t> closed;
+    };
+
+    struct header_t
+    {
+        std::atomic<std::uint64_t> magic;
+        std::uint64_t capacity;
+
+        // Process that created the object, to tell a stale name from a live one.
+        std::int64_t owner;
+
+        ring_t rings[2];  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+public:
+    shm_channel_t(const shm_channel_t& /* that */) = delete;
+
+    shm_channel_t(shm_channel_t&& that) noexcept
+        : m_name(std::move(that.m_name))
+        , m_header(std::exchange(that.m_header, nullptr))
+        , m_size(that.m_size)
+        , m_capacity(that.m_capacity)
+        , m_owner(that.m_owner)
+        , m_identity(that.m_identity)
+        , m_spin(that.m_spin)
+        , m_outgoing(that.m_outgoing)
+        , m_incoming(that.m_incoming)
+        , m_cached_head(that.m_cached_head)
+        , m_cached_tail(that.m_cached_tail)
+    {}
+
+    ~shm_channel_t()
+    {
+        close();
+    }
+
+    shm_channel_t& operator=(const shm_channel_t& /* that */) = delete;
+
+    shm_channel_t& operator=(shm_channel_t&& that) noexcept
+    {
+        if (this != std::addressof(that))
+        {
+            close();
+
+            m_name = std::move(that.m_name);
+            m_header = std::exchange(that.m_header, nullptr);
+            m_size = that.m_size;
+            m_capacity = that.m_capacity;
+            m_owner = that.m_owner;
+            m_identity = that.m_identity;
+            m_spin = that.m_spin;
+            m_outgoing = that.m_outgoing;
+            m_incoming = that.m_incoming;
+            m_cached_head = that.m_cached_head;
+            m_cached_tail = that.m_cached_tail;
+        }
+
+        return *this;
+    }
+
+    // The creator owns the name. By default a name left behind by an owner
+    // that died without close() is replaced, so a restart does not fail; a
+    // name whose owner is still running is never taken over. With recreate
+    // false any existing name is an error.
+    [[nodiscard]] static std::optional<shm_channel_t> create(std::string_view name, std::size_t capacity, bool recreate = true)
+    {
+        capacity = std::bit_ceil(std::max<std::size_t>(capacity, utils::cache_line_size));
+
+        auto path = normalize(name);
+        auto size = sizeof(header_t) + 2 * capacity;
+
+        if (recreate && stale(path))
+        {
+            // A peer still mapping the old object keeps it until it unmaps.
+            ::shm_unlink(path.c_str());
+        }
+
+        auto descriptor = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+
+        if (descriptor == -1)
+        {
+            return std::nullopt;
+        }
+
+        if (::ftruncate(descriptor, static_cast<off_t>(size)) == -1)
+        {
+            ::close(descriptor);
+            ::shm_unlink(path.c_str());
+
+            return std::nullopt;
+        }
+
+        struct stat status
+        {};
+
+        auto* memory = ::fstat(descriptor, &status) == 0 ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0) : MAP_FAILED;
+        ::close(descriptor);
+
+        if (memory == MAP_FAILED)
+        {
+            ::shm_unlink(path.c_str());
+            return std::nullopt;
+        }
+
+        auto* header = ::new (memory) header_t{};
+        header->capacity = capacity;
+        header->owner = ::getpid();
+        header->magic.store(magic, std::memory_order_release);
+
+        shm_channel_t channel(std::move(path), header, size, capacity, true);
+        channel.m_identity = {status.st_dev, status.st_ino};
+
+        return channel;
+    }
+
+    [[nodiscard]] static std::optional<shm_channel_t> open(std::string_view name)
+    {
+        auto path = normalize(name);
+        auto descriptor = ::shm_open(path.c_str(), O_RDWR, 0);
+
+        if (descriptor == -1)
+        {
+            return std::nullopt;
+        }
+
+        struct stat status
+        {};
+
+        if (::fstat(descriptor, &status) == -1 || static_cast<std::size_t>(status.st_size) < sizeof(header_t))
+        {
+            ::close(descriptor);
+            return std::nullopt;
+        }
+
+        auto size = static_cast<std::size_t>(status.st_size);
+        auto* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+
+        ::close(descriptor);
+
+        if (memory == MAP_FAILED)
+        {
+            return std::nullopt;
+        }
+
+        auto* header = static_cast<header_t*>(memory);
+
+        // Read once: the peer could rewrite it later, so only this
+        // validated copy is ever used for indexing.
+        auto capacity = header->capacity;
+        auto valid = header->magic.load(std::memory_order_acquire) == magic && std::has_single_bit(capacity) && capacity <= size / 2 && size == sizeof(header_t) + 2 * capacity;
+
+        if (!valid)
+        {
+            ::munmap(memory, size);
+            return std::nullopt;
+        }
+
+        return shm_channel_t(std::move(path), header, size, static_cast<std::size_t>(capacity), false);
+    }
+
+    void set_busy_poll(std::chrono::nanoseconds budget) noexcept
+    {
+        m_spin = budget;
+    }
+
+    void close() noexcept
+    {
+        if (!m_header)
+        {
+            return;
+        }
+
+        for (auto& ring : m_header->rings)
+        {
+            ring.closed.store(1, std::memory_order_seq_cst);
+
+            wake(ring.readable);
+            wake(ring.writable);
+        }
+
+        ::munmap(m_header, m_size);
+
+        // The name may have been unlinked and taken by another channel
+        // since; that one is not ours to remove.
+        if (m_owner && identity(m_name) == m_identity)
+        {
+            ::shm_unlink(m_name.c_str());
+        }
+
+        m_header = nullptr;
+    }
+
+    [[nodiscard]] result_t<std::size_t, std::error_code> send(std::string_view message)
+    {
+        return send(message.data(), message.length());
+    }
+
+    // Fails with broken_pipe once either side has closed the channel.
+    [[nodiscard]] result_t<std::size_t, std::error_code> send(const void* data, std::size_t length)
+    {
+        auto& ring = outgoing();
+        auto capacity = m_capacity;
+
+        if (ring.closed.load(std::memory_order_acquire))
+        {
+            return fail_t(std::make_error_code(std::errc::broken_pipe));
+        }
+
+        auto tail = ring.tail.load(std::memory_order_relaxed);
+
+        auto has_space = [&] {
+            m_cached_head = ring.head.load(std::memory_order_acquire);
+            return tail - m_cached_head < capacity;
+        };
+
+        if (tail - m_cached_head == capacity && !wait(ring.writable, ring.writer_waiting, ring.closed, has_space, -1))
+        {
+            return fail_t(std::make_error_code(std::errc::broken_pipe));
+        }
+
+        // The peer's head is not trusted to stay within one ring of the tail.
+        auto used = std::min<std::uint64_t>(tail - m_cached_head, capacity);
+        auto count = std::min(length, static_cast<std::size_t>(capacity - used));
+        copy_in(buffer(m_outgoing), capacity, tail, static_cast<const std::byte*>(data), count);
+
+        ring.tail.store(tail + count, std::memory_order_seq_cst);
+
+        if (ring.reader_waiting.load(std::memory_order_seq_cst))
+        {
+            ring.readable.fetch_add(1, std::memory_order_seq_cst);
+            wake(ring.readable);
+        }
+
+        return success_t(count);
+    }
+
+    // Like a socket, zero bytes received means the channel was closed and
+    // everything sent before has been read.
+    [[nodiscard]] result_t<std::size_t, std::error_code> recv(void* data, std::size_t length)
+    {
+        if (auto ready = pool(-1); !ready)
+        {
+            return fail_t(ready.error());
+        }
+
+        auto& ring = incoming();
+        auto capacity = m_capacity;
+
+        auto head = ring.head.load(std::memory_order_relaxed);
+        auto count = std::min(length, static_cast<std::size_t>(std::min<std::uint64_t>(m_cached_tail - head, capacity)));
+
+        if (count == 0)
+        {
+            return success_t(std::size_t{0});
+        }
+
+        copy_out(buffer(m_incoming), capacity, head, static_cast<std::byte*>(data), count);
+
+        ring.head.store(head + count, std::memory_order_seq_cst);
+
+        if (ring.writer_waiting.load(std::memory_order_seq_cst))
+        {
+            ring.writable.fetch_add(1, std::memory_order_seq_cst);
+            wake(ring.writable);
+        }
+
+        return success_t(count);
+    }
+
+    // Never fails; returns 1 once data is readable or the channel closed.
+    [[nodiscard]] result_t<std::size_t, std::error_code> pool(int timeout)
+    {
+        auto& ring = incoming();
+        auto head = ring.head.load(std::memory_order_relaxed);
+
+        auto has_data = [&] {
+            m_cached_tail = ring.tail.load(std::memory_order_acquire);
+            return m_cached_tail != head;
+        };
+
+        if (m_cached_tail != head || has_data())
+        {
+            return success_t(std::size_t{1});
+        }
+
+        if (!wait(ring.readable, ring.reader_waiting, ring.closed, has_data, timeout))
+        {
+            return success_t(std::size_t{ring.closed.load(std::memory_order_acquire) != 0 ? 1U : 0U});
+        }
+
+        return success_t(std::size_t{1});
+    }
+
+private:
+    shm_channel_t(std::string name, header_t* header, std::size_t size, std::size_t capacity, bool owner)
+        : m_name(std::move(name))
+        , m_header(header)
+        , m_size(size)
+        , m_capacity(capacity)
+        , m_owner(owner)
+        , m_outgoing(owner ? 0 : 1)
+        , m_incoming(owner ? 1 : 0)
+    {}
+
+    // Device and inode of the object a name refers to, or zeros.
+    using identity_t = std::pair<dev_t, ino_t>;
+
+    static std::string normalize(std::string_view name)
+    {
+        return (name.starts_with('/') ? "" : "/") + std::string(name);
+    }
+
+    static identity_t identity(const std::string& path) noexcept
+    {
+        auto descriptor = ::shm_open(path.c_str(), O_RDONLY, 0);
+
+        if (descriptor == -1)
+        {
+            return {};
+        }
+
+        struct stat status
+        {};
+
+        auto found = ::fstat(descriptor, &status) == 0;
+        ::close(descriptor);
+
+        return found ? identity_t{status.st_dev, status.st_ino} : identity_t{};
+    }
+
+    // Whether an existing object under path was left by a process that is
+    // gone, or is too short to be a channel at all. One still being set up
+    // by a live creator has no magic yet and is left alone.
+    static bool stale(const std::string& path) noexcept
+    {
+        auto descriptor = ::shm_open(path.c_str(), O_RDONLY, 0);
+
+        if (descriptor == -1)
+        {
+            return false;
+        }
+
+        struct stat status
+        {};
+
+        if (::fstat(descriptor, &status) == -1 || static_cast<std::size_t>(status.st_size) < sizeof(header_t))
+        {
+            ::close(descriptor);
+            return true;
+        }
+
+        auto* memory = ::mmap(nullptr, sizeof(header_t), PROT_READ, MAP_SHARED, descriptor, 0);
+        ::close(descriptor);
+
+        if (memory == MAP_FAILED)
+        {
+            return false;
+        }
+
+        const auto* header = static_cast<const header_t*>(memory);
+
+        auto valid = header->magic.load(std::memory_order_acquire) == magic;
+        auto owner = static_cast<pid_t>(header->owner);
+
+        ::munmap(memory, sizeof(header_t));
+
+        return valid && ::kill(owner, 0) == -1 && errno == ESRCH;
+    }
+
+    ring_t& outgoing() const noexcept
+    {
+        return m_header->rings[m_outgoing];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    ring_t& incoming() const noexcept
+    {
+        return m_header->rings[m_incoming];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    std::byte* buffer(std::size_t index) const noexcept
+    {
+        auto* base = reinterpret_cast<std::byte*>(m_header) + sizeof(header_t);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return base + index * m_capacity;                                 // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    static void copy_in(std::byte* ring, std::size_t capacity, std::uint64_t position, const std::byte* data, std::size_t length) noexcept
+    {
+        auto offset = static_cast<std::size_t>(position & (capacity - 1));
+        auto first = std::min(length, capacity - offset);
+
+        std::memcpy(ring + offset, data, first);                  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(ring, data + first, length - first);          // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    static void copy_out(const std::byte* ring, std::size_t capacity, std::uint64_t position, std::byte* data, std::size_t length) noexcept
+    {
+        auto offset = static_cast<std::size_t>(position & (capacity - 1));
+        auto first = std::min(length, capacity - offset);
+
+        std::memcpy(data, ring + offset, first);                  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(data + first, ring, length - first);          // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    template <typename Predicate>
+    bool wait(std::atomic<std::uint32_t>& signal,
+              std::atomic<std::uint32_t>& waiting,
+              const std::atomic<std::uint32_t>& closed,
+              Predicate ready,
+              int timeout)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::milliseconds(timeout);
+
+        while (std::chrono::steady_clock::now() - start < m_spin && !closed.load(std::memory_order_relaxed))
+        {
+            if (ready())
+            {
+                return true;
+            }
+
+            cpu_relax();
+        }
+
+        while (!closed.load(std::memory_order_acquire))
+        {
+            auto value = signal.load(std::memory_order_seq_cst);
+            waiting.store(1, std::memory_order_seq_cst);
+
+            // ready() loads with acquire only; the fence keeps them after the
+            // store above, pairing with the peer's store of head or tail and
+            // its seq_cst load of the waiting flag. Either the peer sees us
+            // waiting and wakes us, or we see its update.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (ready())
+            {
+                waiting.store(0, std::memory_order_relaxed);
+                return true;
+            }
+
+            if (timeout >= 0 && std::chrono::steady_clock::now() >= deadline)
+            {
+                waiting.store(0, std::memory_order_relaxed);
+                return false;
+            }
+
+            park(signal, value, timeout < 0 ? std::chrono::nanoseconds::max() : deadline - std::chrono::steady_clock::now());
+            waiting.store(0, std::memory_order_relaxed);
+        }
+
+        return ready();
+    }
+
+    static void park(std::atomic<std::uint32_t>& signal, std::uint32_t value, std::chrono::nanoseconds timeout) noexcept
+    {
+#if defined(__linux__)
+        timespec duration{};
+        timespec* limit = nullptr;
+
+        if (timeout != std::chrono::nanoseconds::max())
+        {
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+
+            duration.tv_sec = static_cast<time_t>(seconds.count());
+            duration.tv_nsec = static_cast<long>((timeout - seconds).count());
+
+            limit = &duration;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+        ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&signal), FUTEX_WAIT, value, limit, nullptr, 0);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#else
+        (void)timeout;
+
+        if (signal.load(std::memory_order_acquire) == value)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+#endif
+    }
+
+    static void wake(std::atomic<std::uint32_t>& signal) noexcept
+    {
+#if defined(__linux__)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+        ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&signal), FUTEX_WAKE, 1, nullptr, nullptr, 0);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+#else
+        (void)signal;
+#endif
+    }
+
+    std::string m_name;
+
+    header_t* m_header;
+    std::size_t m_size;
+    std::size_t m_capacity;
+
+    bool m_owner;
+    identity_t m_identity{};
+
+    std::chrono::nanoseconds m_spin{0};
+
+    std::size_t m_outgoing;
+    std::size_t m_incoming;
+
+    std::uint64_t m_cached_head = 0;
+    std::uint64_t m_cached_tail = 0;
+};
+
+#endif  // SHM_CHANNEL_HPP
@@ -11,17 +11,32 @@
     #include <arpa/inet.h>
     #include <netinet/in.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
 
+    #if defined(__linux__)
+        #include <sys/sendfile.h>
+    #endif
+
+    #include <fcntl.h>
     #include <poll.h>
     #include <unistd.h>
 #endif
 
+#include "buffer_chain.hpp"
+#include "endpoint.hpp"
+#include "result.hpp"
+#include "utils.hpp"
+
 /// \cond
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
-#include <optional>
 #include <string_view>
+#include <system_error>
 #include <tuple>
 
 /// \endcond
@@ -49,6 +64,15 @@ static const bool initialized = [] {
 class socket_t
 {
     static constexpr int default_backlog_length = 128;
+    static constexpr std::size_t max_gather_length = 64;
+    static constexpr std::size_t transfer_chunk_size = 64 * 1024;
+
+    // A peer that hung up is reported as EPIPE rather than by SIGPIPE.
+#if defined(MSG_NOSIGNAL)
+    static constexpr int send_flags = MSG_NOSIGNAL;
+#else
+    static constexpr int send_flags = 0;
+#endif
 
 #if defined(_WIN32)
     using descriptor_t = SOCKET;
@@ -59,12 +83,29 @@ class socket_t
 #endif
 
 public:
+    struct transfer_error_t
+    {
+        std::size_t transferred;
+        std::error_code code;
+    };
+
+    using transfer_result_t = result_t<std::size_t, transfer_error_t>;
+
     socket_t()
-        : m_descriptor(::socket(AF_INET, SOCK_STREAM, 0))
+        : socket_t(AF_INET)
+    {}
+
+    explicit socket_t(int family, int type = SOCK_STREAM)
+        : m_descriptor(::socket(family, type, 0))
+        , m_family(family)
+        , m_type(type)
     {}
 
     socket_t(socket_t&& that) noexcept
         : m_descriptor(that.m_descriptor)
+        , m_family(that.m_family)
+        , m_type(that.m_type)
+        , m_spin(that.m_spin)
     {
         that.m_descriptor = invalid_descriptor;
     }
@@ -73,7 +114,13 @@ public:
     {
         if (this != std::addressof(that))
         {
+            this->close();
+
             this->m_descriptor = that.m_descriptor;
+            this->m_family = that.m_family;
+            this->m_type = that.m_type;
+            this->m_spin = that.m_spin;
+
             that.m_descriptor = invalid_descriptor;
         }
 
@@ -88,18 +135,24 @@ public:
     socket_t(const socket_t& /* that */) = delete;
     socket_t& operator=(const socket_t& /* that */) = delete;
 
-    void bind(std::string_view addr, uint16_t port) const
+    [[nodiscard]] status_t bind(std::string_view addr, uint16_t port)
     {
-        sockaddr_in socket{};
+        auto endpoint = endpoint_t::parse(addr, port);
 
-        socket.sin_family = AF_INET;
-        socket.sin_port = htons(port);
+        if (!endpoint)
+        {
+            return fail_t(std::make_error_code(std::errc::invalid_argument));
+        }
 
-        // NOLINTNEXTLINE(bugprone-suspicious-stringview-data-usage)
-        ::inet_pton(AF_INET, addr.data(), &socket.sin_addr);
+        return bind(*endpoint);
+    }
 
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        auto* sock_addr = reinterpret_cast<sockaddr*>(&socket);
+    [[nodiscard]] status_t bind(const endpoint_t& endpoint, bool dual_stack = true)
+    {
+        if (auto status = reopen(endpoint.family()); !status)
+        {
+            return fail_t(status.error());
+        }
 
 #if defined(__WIN32)
         char enable = 1;
@@ -107,45 +160,251 @@ public:
         int enable = 1;
 #endif
 
-        ::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        if (endpoint.family() == AF_INET || endpoint.family() == AF_INET6)
+        {
+            if (::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0)
+            {
+                return fail_t(last_error());
+            }
 
 #if defined(__linux__) || defined(__APPLE__)
-        ::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+            if (::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0)
+            {
+                return fail_t(last_error());
+            }
 #endif
+        }
+
+        if (endpoint.family() == AF_INET6)
+        {
+            enable = dual_stack ? 0 : 1;
+
+            if (::setsockopt(m_descriptor, IPPROTO_IPV6, IPV6_V6ONLY, &enable, sizeof(enable)) != 0)
+            {
+                return fail_t(last_error());
+            }
+        }
 
-        std::ignore = ::bind(m_descriptor, sock_addr, sizeof(socket));
+        if (::bind(m_descriptor, endpoint.data(), endpoint.size()) != 0)
+        {
+            return fail_t(last_error());
+        }
+
+        return {};
     }
 
-    void listen(int backlog = default_backlog_length) const
+    [[nodiscard]] status_t listen(int backlog = default_backlog_length) const
     {
-        std::ignore = ::listen(m_descriptor, backlog);
+        if (::listen(m_descriptor, backlog) != 0)
+        {
+            return fail_t(last_error());
+        }
+
+        return {};
     }
 
-    [[nodiscard]] socket_t accept() const
+    [[nodiscard]] result_t<socket_t, std::error_code> accept() const
     {
-        sockaddr_in socket{};
+        auto descriptor = ::accept(m_descriptor, nullptr, nullptr);
+
+        if (descriptor == invalid_descriptor)
+        {
+            return fail_t(last_error());
+        }
+
+        return success_t(socket_t(descriptor, m_family, m_type));
+    }
+
+    // The peer is only written when a connection was accepted.
+    [[nodiscard]] result_t<socket_t, std::error_code> accept(endpoint_t& peer) const
+    {
+        sockaddr_storage socket{};
         socklen_t socket_length = sizeof(socket);
 
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
         auto* socket_addr = reinterpret_cast<sockaddr*>(&socket);
+        auto descriptor = ::accept(m_descriptor, socket_addr, &socket_length);
 
-        return socket_t(::accept(m_descriptor, socket_addr, &socket_length));
+        if (descriptor == invalid_descriptor)
+        {
+            return fail_t(last_error());
+        }
+
+        peer = endpoint_t(socket_addr, socket_length);
+        return success_t(socket_t(descriptor, m_family, m_type));
+    }
+
+    [[nodiscard]] status_t connect(std::string_view addr, uint16_t port)
+    {
+        auto endpoint = endpoint_t::parse(addr, port);
+
+        if (!endpoint)
+        {
+            return fail_t(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        return connect(*endpoint);
+    }
+
+    [[nodiscard]] status_t connect(const endpoint_t& endpoint)
+    {
+        if (auto status = reopen(endpoint.family()); !status)
+        {
+            return fail_t(status.error());
+        }
+
+        if (::connect(m_descriptor, endpoint.data(), endpoint.size()) != 0)
+        {
+            return fail_t(last_error());
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] status_t connect(std::string_view addr, uint16_t port, std::chrono::milliseconds timeout)
+    {
+        auto endpoint = endpoint_t::parse(addr, port);
+
+        if (!endpoint)
+        {
+            return fail_t(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        return connect(*endpoint, timeout);
     }
 
-    void connect(std::string_view addr, uint16_t port) const
+    [[nodiscard]] status_t connect(const endpoint_t& endpoint, std::chrono::milliseconds timeout)
     {
-        sockaddr_in socket{};
+        if (auto status = reopen(endpoint.family()); !status)
+        {
+            return fail_t(status.error());
+        }
 
-        socket.sin_family = AF_INET;
-        socket.sin_port = htons(port);
+        if (auto status = set_blocking(false); !status)
+        {
+            return fail_t(status.error());
+        }
 
-        // NOLINTNEXTLINE(bugprone-suspicious-stringview-data-usage)
-        ::inet_pton(AF_INET, addr.data(), &socket.sin_addr);
+        // The socket is blocking again on every exit, as after connect().
+        if (auto status = connect_nonblocking(endpoint, timeout); !status)
+        {
+            std::ignore = set_blocking(true);
+            return fail_t(status.error());
+        }
+
+        return set_blocking(true);
+    }
+
+    // The address the socket is bound to, e.g. the port picked for port 0.
+    [[nodiscard]] result_t<endpoint_t, std::error_code> local_endpoint() const
+    {
+        sockaddr_storage socket{};
+        socklen_t socket_length = sizeof(socket);
 
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
         auto* socket_addr = reinterpret_cast<sockaddr*>(&socket);
 
-        std::ignore = ::connect(m_descriptor, socket_addr, sizeof(socket));
+        if (::getsockname(m_descriptor, socket_addr, &socket_length) != 0)
+        {
+            return fail_t(last_error());
+        }
+
+        return success_t(endpoint_t(socket_addr, socket_length));
+    }
+
+    [[nodiscard]] status_t set_blocking(bool enable) const
+    {
+#if defined(__WIN32)
+        u_long mode = enable ? 0 : 1;
+
+        if (::ioctlsocket(m_descriptor, FIONBIO, &mode) != 0)
+        {
+            return fail_t(last_error());
+        }
+#else
+        auto flags = ::fcntl(m_descriptor, F_GETFL, 0);
+
+        if (flags == -1)
+        {
+            return fail_t(last_error());
+        }
+
+        flags = enable ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+
+        if (::fcntl(m_descriptor, F_SETFL, flags) != 0)
+        {
+            return fail_t(last_error());
+        }
+#endif
+
+        return {};
+    }
+
+    [[nodiscard]] status_t set_keepalive(bool enable) const
+    {
+#if defined(__WIN32)
+        char value = enable ? 1 : 0;
+#else
+        int value = enable ? 1 : 0;
+#endif
+
+        if (::setsockopt(m_descriptor, SOL_SOCKET, SO_KEEPALIVE, &value, sizeof(value)) != 0)
+        {
+            return fail_t(last_error());
+        }
+
+        return {};
+    }
+
+    // Spin on non-blocking reads for up to budget before parking the thread
+    // in the kernel. Pays off only when the reader is pinned to its own core.
+    void set_spin(std::chrono::nanoseconds budget) noexcept
+    {
+        m_spin = budget;
+    }
+
+    [[nodiscard]] status_t set_busy_poll(std::chrono::microseconds budget, bool prefer = false) const
+    {
+#if defined(__linux__) && defined(SO_BUSY_POLL)
+        auto value = static_cast<int>(budget.count());
+
+        if (::setsockopt(m_descriptor, SOL_SOCKET, SO_BUSY_POLL, &value, sizeof(value)) != 0)
+        {
+            return fail_t(last_error());
+        }
+
+    #if defined(SO_PREFER_BUSY_POLL)
+        value = prefer ? 1 : 0;
+
+        if (::setsockopt(m_descriptor, SOL_SOCKET, SO_PREFER_BUSY_POLL, &value, sizeof(value)) != 0)
+        {
+            return fail_t(last_error());
+        }
+    #else
+        if (prefer)
+        {
+            return fail_t(std::make_error_code(std::errc::not_supported));
+        }
+    #endif
+
+        return {};
+#else
+        (void)budget;
+        (void)prefer;
+
+        return fail_t(std::make_error_code(std::errc::not_supported));
+#endif
+    }
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return m_descriptor != invalid_descriptor;
+    }
+
+    // For registering with a reactor_t; ownership stays with the socket.
+    [[nodiscard]] descriptor_t descriptor() const noexcept
+    {
+        return m_descriptor;
     }
 
     void close()
@@ -164,12 +423,12 @@ public:
         }
     }
 
-    [[nodiscard]] std::optional<std::size_t> send(std::string_view message) const
+    [[nodiscard]] result_t<std::size_t, std::error_code> send(std::string_view message) const
     {
         return send(message.data(), message.length());
     }
 
-    [[nodiscard]] std::optional<std::size_t> send(const void* data, std::size_t length) const
+    [[nodiscard]] result_t<std::size_t, std::error_code> send(const void* data, std::size_t length) const
     {
 #if defined(__WIN32)
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
@@ -177,20 +436,21 @@ public:
         auto size = static_cast<int>(length);
 #else
         const auto* buffer = data;
-        auto size = static_cast<ssize_t>(length);
+        auto size = length;
 #endif
 
-        auto result = ::send(m_descriptor, buffer, size, 0);
+        auto result = ::send(m_descriptor, buffer, size, send_flags);
 
         if (result == -1)
         {
-            return std::nullopt;
+            return fail_t(last_error());
         }
 
-        return static_cast<std::size_t>(result);
+        return success_t(static_cast<std::size_t>(result));
     }
 
-    [[nodiscard]] std::optional<std::size_t> recv(void* data, std::size_t length) const
+    // Zero bytes received means the peer closed its end.
+    [[nodiscard]] result_t<std::size_t, std::error_code> recv(void* data, std::size_t length) const
     {
 #if defined(__WIN32)
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
@@ -198,20 +458,282 @@ public:
         auto size = static_cast<int>(length);
 #else
         auto* buffer = data;
-        auto size = static_cast<ssize_t>(length);
+        auto size = length;
+#endif
+
+#if !defined(__WIN32)
+        auto start = std::chrono::steady_clock::now();
+
+        while (std::chrono::steady_clock::now() - start < m_spin)
+        {
+            auto result = ::recv(m_descriptor, buffer, size, MSG_DONTWAIT);
+
+            if (result >= 0)
+            {
+                return success_t(static_cast<std::size_t>(result));
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                return fail_t(last_error());
+            }
+
+            cpu_relax();
+        }
 #endif
 
         auto result = ::recv(m_descriptor, buffer, size, 0);
 
-        if (result == 0 || result == -1)
+        if (result == -1)
+        {
+            return fail_t(last_error());
+        }
+
+        return success_t(static_cast<std::size_t>(result));
+    }
+
+    [[nodiscard]] result_t<std::size_t, std::error_code> send(const buffer_chain_t& chain) const
+    {
+        auto segments = chain.segments();
+        auto count = std::min(segments.size(), max_gather_length);
+
+#if defined(__WIN32)
+        std::array<WSABUF, max_gather_length> buffers{};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto data = segments[i].data();
+
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast, cppcoreguidelines-pro-type-reinterpret-cast)
+            buffers[i].buf = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+            buffers[i].len = static_cast<ULONG>(data.size());
+        }
+
+        DWORD sent = 0;
+
+        if (::WSASend(m_descriptor, buffers.data(), static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) != 0)
         {
-            return std::nullopt;
+            return fail_t(last_error());
         }
 
-        return static_cast<std::size_t>(result);
+        return success_t(static_cast<std::size_t>(sent));
+#else
+        std::array<iovec, max_gather_length> buffers{};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto data = segments[i].data();
+
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            buffers[i].iov_base = const_cast<std::byte*>(data.data());
+            buffers[i].iov_len = data.size();
+        }
+
+        msghdr message{};
+
+        message.msg_iov = buffers.data();
+        message.msg_iovlen = count;
+
+        auto result = ::sendmsg(m_descriptor, &message, send_flags);
+
+        if (result == -1)
+        {
+            return fail_t(last_error());
+        }
+
+        return success_t(static_cast<std::size_t>(result));
+#endif
     }
 
-    [[nodiscard]] std::optional<std::size_t> pool(int timeout) const
+    [[nodiscard]] result_t<std::size_t, std::error_code> recv(buffer_chain_t& chain) const
+    {
+        auto buffer = chain.prepare();
+        auto result = recv(buffer.data(), buffer.size());
+
+        if (!result)
+        {
+            return fail_t(result.error());
+        }
+
+        chain.commit(result.value());
+        return success_t(result.value());
+    }
+
+#if !defined(__WIN32)
+    // Streams a file range straight from the page cache. A short count means
+    // the file ended or a non-blocking socket is full; on failure the error
+    // carries the bytes already sent, so the caller resumes at offset plus
+    // transferred either way.
+    [[nodiscard]] transfer_result_t send_file(int file, off_t offset, std::size_t length) const
+    {
+        std::size_t total = 0;
+
+        while (total < length)
+        {
+            auto position = offset + static_cast<off_t>(total);
+    #if defined(__linux__)
+            auto result = ::sendfile(m_descriptor, file, &position, std::min(length - total, transfer_chunk_size));
+    #else
+            std::array<std::byte, transfer_chunk_size> buffer;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+            auto result = ::pread(file, buffer.data(), std::min(length - total, buffer.size()), position);
+
+            if (result > 0 && !send_all(buffer.data(), static_cast<std::size_t>(result)))
+            {
+                return fail_t(transfer_error_t{total, last_error()});
+            }
+    #endif
+            if (result == 0)
+            {
+                break;
+            }
+
+            if (result == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    break;
+                }
+
+                return fail_t(transfer_error_t{total, last_error()});
+            }
+
+            total += static_cast<std::size_t>(result);
+        }
+
+        return success_t(total);
+    }
+
+    // Forwards up to length bytes to target without copying them through user
+    // space, for proxying one connection into another. Like recv() it returns
+    // once the readable data is drained rather than waiting for length bytes.
+    [[nodiscard]] transfer_result_t splice_to(const socket_t& target, std::size_t length) const
+    {
+        std::size_t total = 0;
+
+    #if defined(__linux__)
+        thread_local pipe_t pipe;
+
+        if (!pipe.valid())
+        {
+            return fail_t(transfer_error_t{0, std::make_error_code(std::errc::too_many_files_open)});
+        }
+
+        while (total < length)
+        {
+            if (total != 0)
+            {
+                auto ready = pool(0);
+
+                if (!ready)
+                {
+                    return fail_t(transfer_error_t{total, ready.error()});
+                }
+
+                if (ready.value() == 0)
+                {
+                    break;
+                }
+            }
+
+            auto filled = ::splice(m_descriptor, nullptr, pipe.input(), nullptr, std::min(length - total, transfer_chunk_size), SPLICE_F_MOVE | SPLICE_F_MORE);
+
+            if (filled == 0)
+            {
+                break;
+            }
+
+            if (filled == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    break;
+                }
+
+                return fail_t(transfer_error_t{total, last_error()});
+            }
+
+            auto pending = static_cast<std::size_t>(filled);
+
+            while (pending > 0)
+            {
+                auto drained = ::splice(pipe.output(), nullptr, target.m_descriptor, nullptr, pending, SPLICE_F_MOVE | SPLICE_F_MORE);
+
+                if (drained == -1)
+                {
+                    if (errno == EINTR || ((errno == EAGAIN || errno == EWOULDBLOCK) && target.wait_writable()))
+                    {
+                        continue;
+                    }
+
+                    // Bytes left in the pipe belong to this stream only.
+                    auto code = last_error();
+                    pipe.reset();
+
+                    return fail_t(transfer_error_t{total, code});
+                }
+
+                pending -= static_cast<std::size_t>(drained);
+                total += static_cast<std::size_t>(drained);
+            }
+        }
+    #else
+        std::array<std::byte, transfer_chunk_size> buffer;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+        while (total < length)
+        {
+            if (total != 0)
+            {
+                auto ready = pool(0);
+
+                if (!ready)
+                {
+                    return fail_t(transfer_error_t{total, ready.error()});
+                }
+
+                if (ready.value() == 0)
+                {
+                    break;
+                }
+            }
+
+            auto received = recv(buffer.data(), std::min(length - total, buffer.size()));
+
+            if (!received)
+            {
+                return fail_t(transfer_error_t{total, received.error()});
+            }
+
+            if (received.value() == 0)
+            {
+                break;
+            }
+
+            if (!target.send_all(buffer.data(), received.value()))
+            {
+                return fail_t(transfer_error_t{total, last_error()});
+            }
+
+            total += received.value();
+        }
+    #endif
+
+        return success_t(total);
+    }
+#endif
+
+    // The number of ready descriptors: 0 on timeout, 1 when readable or
+    // hung up.
+    [[nodiscard]] result_t<std::size_t, std::error_code> pool(int timeout) const
     {
         pollfd pfd{};
 
@@ -222,22 +744,236 @@ public:
 #if defined(__WIN32)
         auto result = WSAPoll(std::addressof(pfd), 1, timeout);
 #else
-        auto result = ::poll(std::addressof(pfd), 1, timeout);
+        auto start = std::chrono::steady_clock::now();
+        auto spent = std::chrono::steady_clock::duration::zero();
+
+        while (spent < m_spin && (timeout < 0 || spent < std::chrono::milliseconds(timeout)))
+        {
+            if (::poll(std::addressof(pfd), 1, 0) != 0)
+            {
+                break;
+            }
+
+            cpu_relax();
+            spent = std::chrono::steady_clock::now() - start;
+        }
+
+        if (timeout >= 0)
+        {
+            timeout = std::max(0, timeout - static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(spent).count()));
+        }
+
+        auto result = ::poll(std::addressof(pfd), 1, pfd.revents != 0 ? 0 : timeout);
 #endif
         if (result == -1)
         {
-            return std::nullopt;
+            return fail_t(last_error());
         }
 
-        return static_cast<std::size_t>(result);
+        return success_t(static_cast<std::size_t>(result));
     }
 
 private:
-    explicit socket_t(descriptor_t descriptor)
+    static std::error_code last_error() noexcept
+    {
+#if defined(__WIN32)
+        return {::WSAGetLastError(), std::system_category()};
+#else
+        return {errno, std::system_category()};
+#endif
+    }
+
+#if !defined(__WIN32)
+    class pipe_t
+    {
+    public:
+        pipe_t()
+        {
+            reset();
+        }
+
+        pipe_t(const pipe_t& /* that */) = delete;
+        pipe_t(pipe_t&& /* that */) = delete;
+
+        ~pipe_t()
+        {
+            close();
+        }
+
+        pipe_t& operator=(const pipe_t& /* that */) = delete;
+        pipe_t& operator=(pipe_t&& /* that */) = delete;
+
+        [[nodiscard]] bool valid() const noexcept
+        {
+            return m_descriptors[0] != -1;
+        }
+
+        [[nodiscard]] int output() const noexcept
+        {
+            return m_descriptors[0];
+        }
+
+        [[nodiscard]] int input() const noexcept
+        {
+            return m_descriptors[1];
+        }
+
+        void reset() noexcept
+        {
+            close();
+
+            if (::pipe(m_descriptors.data()) != 0)
+            {
+                m_descriptors.fill(-1);
+            }
+        }
+
+    private:
+        void close() noexcept
+        {
+            for (auto& descriptor : m_descriptors)
+            {
+                if (descriptor != -1)
+                {
+                    ::close(descriptor);
+                    descriptor = -1;
+                }
+            }
+        }
+
+        std::array<int, 2> m_descriptors{-1, -1};
+    };
+
+    [[nodiscard]] bool wait_writable() const
+    {
+        pollfd pfd{};
+
+        pfd.fd = m_descriptor;
+        pfd.events = POLLOUT;
+
+        return ::poll(&pfd, 1, -1) == 1 && (pfd.revents & POLLOUT) != 0;
+    }
+
+    [[nodiscard]] bool send_all(const std::byte* data, std::size_t length) const
+    {
+        while (length > 0)
+        {
+            auto result = ::send(m_descriptor, data, length, send_flags);
+
+            if (result == -1)
+            {
+                if (errno == EINTR || ((errno == EAGAIN || errno == EWOULDBLOCK) && wait_writable()))
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            data += result;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            length -= static_cast<std::size_t>(result);
+        }
+
+        return true;
+    }
+#endif
+
+    [[nodiscard]] status_t connect_nonblocking(const endpoint_t& endpoint, std::chrono::milliseconds timeout) const
+    {
+        if (::connect(m_descriptor, endpoint.data(), endpoint.size()) == 0)
+        {
+            return {};
+        }
+
+#if defined(__WIN32)
+        auto pending = (::WSAGetLastError() == WSAEWOULDBLOCK);
+#else
+        auto pending = (errno == EINPROGRESS);
+#endif
+
+        if (!pending)
+        {
+            return fail_t(last_error());
+        }
+
+        pollfd pfd{};
+
+        pfd.fd = m_descriptor;
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
+
+#if defined(__WIN32)
+        auto result = WSAPoll(std::addressof(pfd), 1, static_cast<int>(timeout.count()));
+#else
+        auto result = ::poll(std::addressof(pfd), 1, static_cast<int>(timeout.count()));
+#endif
+
+        if (result == 0)
+        {
+            return fail_t(std::make_error_code(std::errc::timed_out));
+        }
+
+        if (result != 1)
+        {
+            return fail_t(last_error());
+        }
+
+#if defined(__WIN32)
+        char error = 0;
+#else
+        int error = 0;
+#endif
+
+        socklen_t length = sizeof(error);
+
+        if (::getsockopt(m_descriptor, SOL_SOCKET, SO_ERROR, &error, &length) != 0)
+        {
+            return fail_t(last_error());
+        }
+
+        if (error != 0)
+        {
+            return fail_t(std::error_code(error, std::system_category()));
+        }
+
+        return {};
+    }
+
+    socket_t(descriptor_t descriptor, int family, int type)
         : m_descriptor(descriptor)
+        , m_family(family)
+        , m_type(type)
     {}
 
+    // A socket of another family needs a new descriptor; options set on
+    // the old one (blocking mode, keepalive, busy polling) do not carry over,
+    // so set them after bind() or connect().
+    [[nodiscard]] status_t reopen(int family)
+    {
+        if (family == m_family || family == AF_UNSPEC)
+        {
+            return {};
+        }
+
+        close();
+
+        m_descriptor = ::socket(family, m_type, 0);
+        m_family = family;
+
+        if (m_descriptor == invalid_descriptor)
+        {
+            return fail_t(last_error());
+        }
+
+        return {};
+    }
+
     descriptor_t m_descriptor;
+
+    int m_family;
+    int m_type;
+
+    std::chrono::nanoseconds m_spin{0};
 };
 
 #endif  // SOCKET_HPP
@@ -7,11 +7,35 @@
 #if defined(__linux__)
     #include <pthread.h>
     #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
 #endif  // __linux__
 
+#include "crash.hpp"
+#include "per_thread.hpp"
+#include "result.hpp"
+
 /// \cond
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
 #include <string_view>
+#include <system_error>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 /// \endcond
@@ -19,15 +43,115 @@
 /*****************************************************************************/
 /*** CLASSES *****************************************************************/
 
+// std::thread with a stop_source, like std::jthread: callables that take a
+// std::stop_token first get one, and destruction requests a stop before it
+// joins. Loops blocked in I/O should wait through reactor_t::run(token),
+// which the stop wakes. join_for() bounds the wait for a thread that does
+// not react.
 class thread_t
 {
+    // Shared with the running thread: its kernel id, published as it
+    // starts, and a flag set when the callable returns, since std::thread
+    // has no timed join.
+    struct state_t
+    {
+        void start() noexcept
+        {
+#if defined(__linux__)
+            tid.store(static_cast<long>(::syscall(SYS_gettid)), std::memory_order_release);  // NOLINT(google-runtime-int)
+            tid.notify_all();
+#endif
+        }
+
+        void finish()
+        {
+            {
+                std::lock_guard lock(mutex);
+                done = true;
+            }
+
+            finished.notify_all();
+        }
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done = false;
+
+        std::atomic<long> tid{0};  // NOLINT(google-runtime-int)
+    };
+
 public:
+    enum class policy_t
+    {
+        normal,       // SCHED_OTHER, weighted by nice
+        batch,        // SCHED_BATCH, throughput work that should not preempt
+        idle,         // SCHED_IDLE, runs only when nothing else wants the core
+        fifo,         // SCHED_FIFO, priority 1-99, runs until it blocks
+        round_robin,  // SCHED_RR, as fifo with a time slice among equals
+    };
+
+    // Everything a latency-sensitive or background thread usually needs,
+    // applied in one go by configure().
+    struct scheduling_t
+    {
+        int core = -1;
+        policy_t policy = policy_t::normal;
+
+        // Real-time priority for fifo and round_robin, 0 otherwise.
+        int priority = 0;
+
+        // -20 (favoured) to 19; applies to normal and batch.
+        int nice = 0;
+    };
+
+    // Whether a core is kept free of other work by the kernel command line.
+    // A pinned latency-sensitive thread on a core that is neither isolated
+    // nor nohz_full shares it with the scheduler tick and other tasks.
+    struct isolation_t
+    {
+        bool isolated = false;   // isolcpus
+        bool nohz_full = false;  // no scheduler tick while one task runs
+
+        [[nodiscard]] bool any() const noexcept
+        {
+            return isolated || nohz_full;
+        }
+    };
+
     thread_t() = default;
 
+    // The new thread takes its thread_registry index, and an alternate
+    // signal stack once crash::install() has run, before running fn.
     template <typename F, typename... Args>
     explicit thread_t(F&& fn, Args&&... args)
-        : m_thread(std::forward<F>(fn), std::forward<Args>(args)...)
-    {}
+        : m_stop()
+        , m_state(std::make_shared<state_t>())
+    {
+        m_thread = std::thread(
+            [state = m_state, token = m_stop.get_token()](auto function, auto... arguments) {
+                std::ignore = thread_registry::index();
+
+                if (crash::installed())
+                {
+                    std::ignore = crash::protect_this_thread();
+                }
+
+                state->start();
+
+                if constexpr (std::is_invocable_v<decltype(function), std::stop_token, decltype(arguments)...>)
+                {
+                    std::invoke(std::move(function), token, std::move(arguments)...);
+                }
+                else
+                {
+                    std::invoke(std::move(function), std::move(arguments)...);
+                }
+
+                state->finish();
+            },
+            std::forward<F>(fn),
+            std::forward<Args>(args)...);
+    }
 
     thread_t(const thread_t& /* that */) = delete;
     thread_t(thread_t&& /* that */) = default;
@@ -36,6 +160,7 @@ public:
     {
         if (m_thread.joinable())
         {
+            m_stop.request_stop();
             m_thread.join();
         }
     }
@@ -53,55 +178,314 @@ public:
         m_thread.join();
     }
 
-    void set_name(std::string_view name)
+    // True once the thread finished and was joined; false if it is still
+    // running after timeout, in which case it stays joinable.
+    template <typename Rep, typename Period>
+    [[nodiscard]] bool join_for(std::chrono::duration<Rep, Period> timeout)
+    {
+        if (!m_thread.joinable())
+        {
+            return false;
+        }
+
+        {
+            std::unique_lock lock(m_state->mutex);
+
+            if (!m_state->finished.wait_for(lock, timeout, [this] { return m_state->done; }))
+            {
+                return false;
+            }
+        }
+
+        // Only thread-local destructors are left to run.
+        m_thread.join();
+        return true;
+    }
+
+    // Returns false if a stop was already requested.
+    bool request_stop() noexcept
+    {
+        return m_stop.request_stop();
+    }
+
+    [[nodiscard]] std::stop_token get_stop_token() const noexcept
+    {
+        return m_stop.get_token();
+    }
+
+    [[nodiscard]] std::stop_source get_stop_source() const noexcept
+    {
+        return m_stop;
+    }
+
+    [[nodiscard]] status_t set_name(std::string_view name)
     {
         if (m_thread.get_id() == std::thread::id())
         {
-            return;
+            return fail_t(std::make_error_code(std::errc::no_such_process));
         }
 
 #if defined(__linux__)
-        pthread_setname_np(m_thread.native_handle(), name.data());
+        // Thread names are limited to 15 characters plus the terminator.
+        std::string terminated(name.substr(0, 15));
+
+        if (auto error = pthread_setname_np(m_thread.native_handle(), terminated.c_str()); error != 0)
+        {
+            return fail_t(std::error_code(error, std::system_category()));
+        }
+
+        return {};
 #else
         (void)name;
+        return fail_t(std::make_error_code(std::errc::not_supported));
 #endif
     }
 
-    void set_affinity(int core)
+    [[nodiscard]] status_t set_affinity(int core)
     {
-        if (m_thread.get_id() == std::thread::id() || core == -1)
+        if (core == -1)
+        {
+            return {};
+        }
+
+        if (m_thread.get_id() == std::thread::id())
         {
-            return;
+            return fail_t(std::make_error_code(std::errc::no_such_process));
         }
 
 #if defined(__linux__)
-        cpu_set_t cpuset{};
+        return pin(m_thread.native_handle(), core);
+#else
+        return fail_t(std::make_error_code(std::errc::not_supported));
+#endif
+    }
 
-        CPU_ZERO(&cpuset);
-        CPU_SET(static_cast<std::size_t>(core), &cpuset);
+    [[nodiscard]] status_t set_scheduling(policy_t policy, int priority = 0)
+    {
+        if (m_thread.get_id() == std::thread::id())
+        {
+            return fail_t(std::make_error_code(std::errc::no_such_process));
+        }
+
+#if defined(__linux__)
+        auto native = native_policy(policy);
+
+        if (priority < ::sched_get_priority_min(native) || priority > ::sched_get_priority_max(native))
+        {
+            return fail_t(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        sched_param parameters{};
+        parameters.sched_priority = priority;
+
+        // Real-time policies need CAP_SYS_NICE or an RLIMIT_RTPRIO allowance,
+        // otherwise this reports EPERM.
+        if (auto error = pthread_setschedparam(m_thread.native_handle(), native, &parameters); error != 0)
+        {
+            return fail_t(std::error_code(error, std::system_category()));
+        }
 
-        pthread_setaffinity_np(m_thread.native_handle(), sizeof(cpuset), &cpuset);
+        return {};
+#else
+        (void)policy;
+        (void)priority;
+        return fail_t(std::make_error_code(std::errc::not_supported));
 #endif
     }
 
-    static void pin_this_thread_to_core(int index)
+    // Lowering the nice value (raising priority) needs CAP_SYS_NICE or an
+    // RLIMIT_NICE allowance.
+    [[nodiscard]] status_t set_nice(int nice)
+    {
+        if (m_thread.get_id() == std::thread::id())
+        {
+            return fail_t(std::make_error_code(std::errc::no_such_process));
+        }
+
+#if defined(__linux__)
+        // On Linux the nice value belongs to the thread, addressed by its
+        // kernel id, which the thread publishes as it starts.
+        m_state->tid.wait(0, std::memory_order_acquire);
+
+        auto tid = static_cast<id_t>(m_state->tid.load(std::memory_order_acquire));
+
+        if (::setpriority(PRIO_PROCESS, tid, nice) != 0)
+        {
+            return fail_t(std::error_code(errno, std::system_category()));
+        }
+
+        return {};
+#else
+        (void)nice;
+        return fail_t(std::make_error_code(std::errc::not_supported));
+#endif
+    }
+
+    // Pins, sets the policy and nice value and reports how isolated the
+    // chosen core is, so callers can warn about a latency-sensitive thread
+    // pinned onto a shared core. Stops at the first step that fails.
+    [[nodiscard]] result_t<isolation_t, std::error_code> configure(const scheduling_t& scheduling)
+    {
+        if (auto result = set_affinity(scheduling.core); !result)
+        {
+            return fail_t(result.error());
+        }
+
+        if (auto result = set_scheduling(scheduling.policy, scheduling.priority); !result)
+        {
+            return fail_t(result.error());
+        }
+
+        if (scheduling.policy == policy_t::normal || scheduling.policy == policy_t::batch)
+        {
+            if (auto result = set_nice(scheduling.nice); !result)
+            {
+                return fail_t(result.error());
+            }
+        }
+
+        return success_t(isolation(scheduling.core));
+    }
+
+    // Locks current and future pages of the whole process into memory, so
+    // a real-time thread never waits on a page fault served from disk.
+    // Needs CAP_IPC_LOCK or a large enough RLIMIT_MEMLOCK.
+    [[nodiscard]] static status_t lock_memory()
+    {
+#if defined(__linux__)
+        if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            return fail_t(std::error_code(errno, std::system_category()));
+        }
+
+        return {};
+#else
+        return fail_t(std::make_error_code(std::errc::not_supported));
+#endif
+    }
+
+    [[nodiscard]] static isolation_t isolation(int core)
+    {
+        isolation_t result;
+
+#if defined(__linux__)
+        if (core >= 0)
+        {
+            result.isolated = listed(read_cpu_list("/sys/devices/system/cpu/isolated"), core);
+            result.nohz_full = listed(read_cpu_list("/sys/devices/system/cpu/nohz_full"), core);
+        }
+#else
+        (void)core;
+#endif
+
+        return result;
+    }
+
+    // Whether core appears in a kernel cpu list such as "0,2-5,8".
+    [[nodiscard]] static bool listed(std::string_view list, int core) noexcept
+    {
+        while (!list.empty())
+        {
+            auto range = list.substr(0, list.find(','));
+            list.remove_prefix(std::min(list.size(), range.size() + 1));
+
+            int first = -1;
+            auto [end, error] = std::from_chars(range.data(), range.data() + range.size(), first);
+
+            if (error != std::errc())
+            {
+                continue;
+            }
+
+            auto last = first;
+
+            if (end != range.data() + range.size() && *end == '-')
+            {
+                ++end;
+
+                if (std::from_chars(end, range.data() + range.size(), last).ec != std::errc())
+                {
+                    continue;
+                }
+            }
+
+            if (core >= first && core <= last)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] static status_t pin_this_thread_to_core(int index)
     {
         if (index == -1)
         {
-            return;
+            return {};
         }
 
 #if defined(__linux__)
+        return pin(pthread_self(), index);
+#else
+        return fail_t(std::make_error_code(std::errc::not_supported));
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    static status_t pin(pthread_t thread, int core)
+    {
+        if (core < 0 || core >= CPU_SETSIZE)
+        {
+            return fail_t(std::make_error_code(std::errc::invalid_argument));
+        }
+
         cpu_set_t cpuset{};
 
         CPU_ZERO(&cpuset);
-        CPU_SET(core, &cpuset);
+        CPU_SET(static_cast<std::size_t>(core), &cpuset);
 
-        pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
-#endif
+        // pthread functions return the error instead of setting errno.
+        if (auto error = pthread_setaffinity_np(thread, sizeof(cpuset), &cpuset); error != 0)
+        {
+            return fail_t(std::error_code(error, std::system_category()));
+        }
+
+        return {};
     }
 
-private:
+    static int native_policy(policy_t policy) noexcept
+    {
+        switch (policy)
+        {
+            case policy_t::batch:
+                return SCHED_BATCH;
+            case policy_t::idle:
+                return SCHED_IDLE;
+            case policy_t::fifo:
+                return SCHED_FIFO;
+            case policy_t::round_robin:
+                return SCHED_RR;
+            case policy_t::normal:
+            default:
+                return SCHED_OTHER;
+        }
+    }
+
+    static std::string read_cpu_list(const char* path)
+    {
+        std::string list;
+        std::ifstream file(path);
+
+        std::getline(file, list);
+        return list;
+    }
+#endif
+
+    std::stop_source m_stop{std::nostopstate};
+    std::shared_ptr<state_t> m_state;
+
     std::thread m_thread;
 };
 
@@ -4,10 +4,14 @@
 /*****************************************************************************/
 /*** HEADER INCLUDES *********************************************************/
 
+#include "result.hpp"
+
 /// \cond
 #include <chrono>
+#include <concepts>
 #include <cstddef>
 #include <functional>
+#include <system_error>
 #include <utility>
 
 /// \endcond
@@ -30,6 +34,15 @@ namespace utils
 
     inline constexpr nothing_t nothing{};
     inline constexpr something_t something{};
+
+    inline constexpr std::size_t cache_line_size = 64;
+
+    template <typename T>
+    concept stream_transport = requires(T& transport, void* output, const void* input, std::size_t length, int timeout) {
+        { transport.send(input, length) } -> std::same_as<result_t<std::size_t, std::error_code>>;
+        { transport.recv(output, length) } -> std::same_as<result_t<std::size_t, std::error_code>>;
+        { transport.pool(timeout) } -> std::same_as<result_t<std::size_t, std::error_code>>;
+    };
 }  // namespace utils
 
 /*****************************************************************************/
@@ -46,6 +59,15 @@ void repeat_for(F&& fn, Args&&... args)
     }
 }
 
-void annotate_and_terminate(const char* message, const char* file, int line);
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+[[noreturn]] void annotate_and_terminate(const char* message, const char* file, int line);
 
 #endif  // UTILS_HPP
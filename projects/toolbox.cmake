@@ -6,6 +6,8 @@ find_path(REPLXX_INCLUDE_DIR NAMES "replxx.hxx")
 
 setup_library(toolbox
     SOURCES
+        src/crash.cpp
+        src/scan.cpp
         src/utils.cpp
     INCLUDES
         include
@@ -18,13 +20,66 @@ setup_library(toolbox
 
 setup_executable(toolbox-test
     SOURCES
+        tests/admin_shell.cpp
+        tests/arena.cpp
+        tests/buffer_chain.cpp
+        tests/command_registry.cpp
+        tests/command_table.cpp
+        tests/connection_pool.cpp
+        tests/crash.cpp
         tests/either.cpp
+        tests/endpoint.cpp
+        tests/framing.cpp
+        tests/hugepage.cpp
         tests/maybe.cpp
+        tests/metrics.cpp
+        tests/mmap_file.cpp
+        tests/multiversion.cpp
+        tests/parallel.cpp
+        tests/per_thread.cpp
+        tests/pool.cpp
+        tests/rcu.cpp
+        tests/reactor.cpp
+        tests/resolver.cpp
+        tests/result.cpp
+        tests/scan.cpp
+        tests/seqlock.cpp
+        tests/shm_channel.cpp
+        tests/socket.cpp
+        tests/thread.cpp
     INCLUDES
         include
     DEPENDENCIES
+        toolbox
         Catch2::Catch2WithMain
 )
 
 catch_discover_tests(toolbox-test)
 add_coverage(toolbox-test)
+
+if(benchmark_FOUND)
+    setup_executable(toolbox-bench
+        SOURCES
+            benchmarks/command_table.cpp
+            benchmarks/parallel.cpp
+            benchmarks/pool.cpp
+            benchmarks/scan.cpp
+        INCLUDES
+            include
+        DEPENDENCIES
+            toolbox
+            benchmark::benchmark_main
+        TRAINING
+        TRAINING_ARGUMENTS
+            --benchmark_min_time=0.2s
+    )
+
+    # libstdc++ runs std::execution::par on TBB; without it the parallel
+    # benchmarks compare against serial code only.
+    find_package(TBB QUIET)
+
+    if(TBB_FOUND)
+        target_link_libraries(toolbox-bench PRIVATE TBB::tbb)
+        target_compile_definitions(toolbox-bench PRIVATE TOOLBOX_PARALLEL_STL)
+    endif()
+endif()
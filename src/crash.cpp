@@ -0,0 +1,541 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "crash.hpp"
+
+#if defined(__linux__) || defined(__APPLE__)
+    #include <execinfo.h>
+    #include <fcntl.h>
+    #include <signal.h>
+    #include <unistd.h>
+
+    #define CRASH_SIGNALS 1
+#endif
+
+#if defined(__linux__)
+    #include <dirent.h>
+    #include <sys/syscall.h>
+#endif
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** HANDLER *****************************************************************/
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-type-union-access)
+
+namespace
+{
+    constexpr int error_output = 2;
+    constexpr std::size_t max_frames = 64;
+    constexpr std::size_t alternate_stack_size = 64 * 1024;
+
+    // Everything the handler touches lives here, reserved before any crash:
+    // function-local statics would take a guard lock on first use.
+    std::array<std::atomic<crash::hook_t>, crash::max_hooks> hooks{};
+    std::array<void*, max_frames> frames{};
+
+#if defined(__linux__)
+    alignas(dirent64) std::array<char, 4096> entries{};
+#endif
+
+    int crash_file = -1;
+    bool dump_threads = false;
+    unsigned hook_timeout = 5;
+
+    std::atomic<bool> handling{false};
+    std::atomic<bool> armed{false};
+
+    // The signal being reported, for the alarm to re-raise.
+    std::atomic<int> fatal_signal{0};
+
+    void write_all(int descriptor, const char* data, std::size_t length) noexcept
+    {
+#if defined(CRASH_SIGNALS)
+        while (length > 0 && descriptor >= 0)
+        {
+            auto written = ::write(descriptor, data, length);
+
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (written <= 0)
+            {
+                return;
+            }
+
+            data += written;
+            length -= static_cast<std::size_t>(written);
+        }
+#else
+        (void)descriptor;
+        std::fwrite(data, 1, length, stderr);
+#endif
+    }
+
+    // Formats into its own buffer without allocating or locking and writes
+    // to stderr and the crash file.
+    class writer_t
+    {
+    public:
+        writer_t() = default;
+
+        writer_t(const writer_t& /* that */) = delete;
+        writer_t(writer_t&& /* that */) = delete;
+
+        ~writer_t()
+        {
+            flush();
+        }
+
+        writer_t& operator=(const writer_t& /* that */) = delete;
+        writer_t& operator=(writer_t&& /* that */) = delete;
+
+        writer_t& operator<<(std::string_view text) noexcept
+        {
+            for (auto character : text)
+            {
+                if (m_size == m_buffer.size())
+                {
+                    flush();
+                }
+
+                m_buffer.at(m_size++) = character;
+            }
+
+            return *this;
+        }
+
+        writer_t& operator<<(const char* text) noexcept
+        {
+            return *this << std::string_view(text ? text : "(null)");
+        }
+
+        writer_t& operator<<(std::intmax_t value) noexcept
+        {
+            if (value < 0)
+            {
+                *this << "-";
+            }
+
+            auto magnitude = value < 0 ? 0 - static_cast<std::uintmax_t>(value) : static_cast<std::uintmax_t>(value);
+            return number(magnitude, 10);
+        }
+
+        writer_t& hex(std::uintmax_t value) noexcept
+        {
+            *this << "0x";
+            return number(value, 16);
+        }
+
+        void flush() noexcept
+        {
+            write_all(error_output, m_buffer.data(), m_size);
+            write_all(crash_file, m_buffer.data(), m_size);
+
+            m_size = 0;
+        }
+
+    private:
+        writer_t& number(std::uintmax_t value, unsigned base) noexcept
+        {
+            std::array<char, 24> digits{};
+            std::size_t count = 0;
+
+            do
+            {
+                digits.at(count++) = "0123456789abcdef"[value % base];
+                value /= base;
+            } while (value != 0);
+
+            while (count > 0)
+            {
+                *this << std::string_view(&digits.at(--count), 1);
+            }
+
+            return *this;
+        }
+
+        std::array<char, 1024> m_buffer{};
+        std::size_t m_size = 0;
+    };
+
+#if defined(CRASH_SIGNALS)
+    constexpr std::array fatal_signals = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+
+    const char* signal_name(int signal) noexcept
+    {
+        switch (signal)
+        {
+            case SIGSEGV:
+                return "SIGSEGV";
+            case SIGBUS:
+                return "SIGBUS";
+            case SIGFPE:
+                return "SIGFPE";
+            case SIGILL:
+                return "SIGILL";
+            case SIGABRT:
+                return "SIGABRT";
+            default:
+                return "signal";
+        }
+    }
+
+    std::intmax_t thread_id() noexcept
+    {
+    #if defined(__linux__)
+        return ::syscall(SYS_gettid);
+    #else
+        return ::getpid();
+    #endif
+    }
+
+    #if defined(__linux__)
+    // One line per thread from /proc/self/task/<id>/stat: "id (name) state".
+    void print_thread(writer_t& out, const char* id) noexcept
+    {
+        std::array<char, 64> path{};
+        std::size_t length = 0;
+
+        for (auto part : {"/proc/self/task/", id, "/stat"})
+        {
+            for (; *part != '\0' && length + 1 < path.size(); ++part)
+            {
+                path.at(length++) = *part;
+            }
+        }
+
+        auto descriptor = ::open(path.data(), O_RDONLY | O_CLOEXEC);
+
+        if (descriptor < 0)
+        {
+            return;
+        }
+
+        std::array<char, 256> stat{};
+        auto size = ::read(descriptor, stat.data(), stat.size());
+        ::close(descriptor);
+
+        if (size <= 0)
+        {
+            return;
+        }
+
+        // The name may itself contain ") ", so take the last parenthesis.
+        auto text = std::string_view(stat.data(), static_cast<std::size_t>(size));
+        auto end = text.rfind(')');
+
+        if (end != std::string_view::npos)
+        {
+            text = text.substr(0, std::min(end + 3, text.size()));
+        }
+
+        out << "  " << text << "\n";
+    }
+
+    void print_threads(writer_t& out) noexcept
+    {
+        auto directory = ::open("/proc/self/task", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        if (directory < 0)
+        {
+            return;
+        }
+
+        out << "Threads:\n";
+
+        while (true)
+        {
+            auto size = ::syscall(SYS_getdents64, directory, entries.data(), entries.size());
+
+            if (size <= 0)
+            {
+                break;
+            }
+
+            for (long offset = 0; offset < size;)  // NOLINT(google-runtime-int)
+            {
+                const auto* entry = reinterpret_cast<const dirent64*>(entries.data() + offset);
+
+                if (entry->d_name[0] != '.')
+                {
+                    print_thread(out, static_cast<const char*>(entry->d_name));
+                }
+
+                offset += entry->d_reclen;
+            }
+        }
+
+        ::close(directory);
+    }
+    #endif
+
+    // A hook that hangs must not turn a crash into a SIGALRM exit without a
+    // core: end the process with the signal that started the report.
+    void expire(int /* signal */)
+    {
+        {
+            writer_t out;
+            out << "Crash hooks timed out\n";
+        }
+
+        auto signal = fatal_signal.load();
+
+        // This thread may be the reporting one, with the signal blocked.
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, signal);
+
+        ::signal(signal, SIG_DFL);
+        ::pthread_sigmask(SIG_UNBLOCK, &mask, nullptr);
+        ::raise(signal);
+    }
+
+    void handle(int signal, siginfo_t* info, void* /* context */)
+    {
+        if (handling.exchange(true))
+        {
+            // Another thread is reporting and will take the process down.
+            while (true)
+            {
+                ::pause();
+            }
+        }
+
+        // Nothing below may hang the process for good, hooks included.
+        fatal_signal.store(signal);
+
+        struct sigaction timeout = {};
+        timeout.sa_handler = expire;
+        timeout.sa_flags = SA_ONSTACK;
+        sigemptyset(&timeout.sa_mask);
+
+        ::sigaction(SIGALRM, &timeout, nullptr);
+        ::alarm(hook_timeout);
+
+        {
+            writer_t out;
+            out << "\nFatal " << signal_name(signal) << " in thread " << thread_id();
+
+            // Only faults raised by the kernel carry an address.
+            if (signal != SIGABRT && info->si_code > 0)
+            {
+                out << " at address ";
+                out.hex(reinterpret_cast<std::uintptr_t>(info->si_addr));
+            }
+
+            out << "\nBacktrace:\n";
+        }
+
+        auto count = ::backtrace(frames.data(), static_cast<int>(frames.size()));
+
+        ::backtrace_symbols_fd(frames.data(), count, error_output);
+
+        if (crash_file >= 0)
+        {
+            ::backtrace_symbols_fd(frames.data(), count, crash_file);
+        }
+
+    #if defined(__linux__)
+        if (dump_threads)
+        {
+            writer_t out;
+            print_threads(out);
+        }
+    #endif
+
+        for (const auto& slot : hooks)
+        {
+            if (auto hook = slot.load(std::memory_order_acquire))
+            {
+                hook(crash_file);
+            }
+        }
+
+        if (crash_file >= 0)
+        {
+            ::fsync(crash_file);
+        }
+
+        // The signal stays blocked until the handler returns; then the default
+        // action ends the process with the original status and core dump.
+        ::signal(signal, SIG_DFL);
+        ::raise(signal);
+    }
+
+    // Freed when its thread exits; disabled first so the kernel never
+    // switches to a stack that is gone.
+    class alternate_stack_t
+    {
+    public:
+        alternate_stack_t() = default;
+
+        alternate_stack_t(const alternate_stack_t& /* that */) = delete;
+        alternate_stack_t(alternate_stack_t&& /* that */) = delete;
+
+        ~alternate_stack_t()
+        {
+            if (m_memory)
+            {
+                stack_t disabled{};
+                disabled.ss_flags = SS_DISABLE;
+
+                ::sigaltstack(&disabled, nullptr);
+            }
+        }
+
+        alternate_stack_t& operator=(const alternate_stack_t& /* that */) = delete;
+        alternate_stack_t& operator=(alternate_stack_t&& /* that */) = delete;
+
+        [[nodiscard]] bool enable()
+        {
+            if (m_memory)
+            {
+                return true;
+            }
+
+            auto memory = std::make_unique<std::byte[]>(alternate_stack_size);  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+
+            stack_t stack{};
+            stack.ss_sp = memory.get();
+            stack.ss_size = alternate_stack_size;
+
+            if (::sigaltstack(&stack, nullptr) != 0)
+            {
+                return false;
+            }
+
+            m_memory = std::move(memory);
+            return true;
+        }
+
+    private:
+        std::unique_ptr<std::byte[]> m_memory;  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+    };
+#endif
+}  // namespace
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-type-union-access)
+
+/*****************************************************************************/
+/*** MEMBER FUNCTIONS ********************************************************/
+
+status_t crash::install()
+{
+    return install(options_t{});
+}
+
+status_t crash::install(const options_t& options)
+{
+#if defined(CRASH_SIGNALS)
+    if (options.file)
+    {
+        crash_file = ::open(options.file, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+        if (crash_file < 0)
+        {
+            return fail_t(std::error_code(errno, std::system_category()));
+        }
+    }
+
+    dump_threads = options.threads;
+    hook_timeout = options.hook_timeout;
+
+    // The first backtrace() loads the unwinder, which allocates; do it now.
+    std::ignore = ::backtrace(frames.data(), 1);
+
+    if (auto result = protect_this_thread(); !result)
+    {
+        return fail_t(result.error());
+    }
+
+    struct sigaction action = {};
+    action.sa_sigaction = handle;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+
+    // One report at a time per thread: a fault inside the handler kills
+    // the process instead of recursing.
+    sigemptyset(&action.sa_mask);
+
+    for (auto signal : fatal_signals)
+    {
+        sigaddset(&action.sa_mask, signal);
+    }
+
+    for (auto signal : fatal_signals)
+    {
+        if (::sigaction(signal, &action, nullptr) != 0)
+        {
+            return fail_t(std::error_code(errno, std::system_category()));
+        }
+    }
+
+    armed.store(true, std::memory_order_release);
+    return {};
+#else
+    (void)options;
+    return fail_t(std::make_error_code(std::errc::not_supported));
+#endif
+}
+
+status_t crash::protect_this_thread()
+{
+#if defined(CRASH_SIGNALS)
+    thread_local alternate_stack_t stack;
+
+    if (!stack.enable())
+    {
+        return fail_t(std::error_code(errno, std::system_category()));
+    }
+
+    return {};
+#else
+    return fail_t(std::make_error_code(std::errc::not_supported));
+#endif
+}
+
+bool crash::installed() noexcept
+{
+    return armed.load(std::memory_order_acquire);
+}
+
+bool crash::on_crash(hook_t hook) noexcept
+{
+    for (auto& slot : hooks)
+    {
+        hook_t expected = nullptr;
+
+        if (slot.compare_exchange_strong(expected, hook, std::memory_order_acq_rel) || expected == hook)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void crash::annotate(const char* message, const char* file, int line) noexcept
+{
+    writer_t out;
+
+    out << "Program panicked with\n"
+        << "  " << message << "\n"
+        << "On File: " << file << "\n"
+        << "At Line: " << std::intmax_t{line} << "\n";
+}
@@ -0,0 +1,507 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "scan.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+
+    #define SCAN_X86 1
+#endif
+
+/// \cond
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** KERNELS *****************************************************************/
+
+// Vector registers do not fit std::array (their attributes are dropped), so
+// the needle sets are plain arrays.
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-constant-array-index, cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays, cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+
+namespace
+{
+    using scan::field_t;
+
+    // Fills the caller's field slots; the last slot is kept for the tail, so
+    // emit() reports when the kernel has to stop splitting.
+    class splitter_t
+    {
+    public:
+        splitter_t(const std::byte* data, std::size_t length, std::span<field_t> fields) noexcept
+            : m_data(data)
+            , m_length(length)
+            , m_fields(fields)
+        {}
+
+        bool emit(std::size_t position) noexcept
+        {
+            m_fields[m_count++] = field_t(m_data + m_start, position - m_start);
+            m_start = position + 1;
+
+            return m_count + 1 < m_fields.size();
+        }
+
+        std::size_t finish() noexcept
+        {
+            m_fields[m_count++] = field_t(m_data + m_start, m_length - m_start);
+            return m_count;
+        }
+
+    private:
+        const std::byte* m_data;
+        std::size_t m_length;
+
+        std::span<field_t> m_fields;
+        std::size_t m_count = 0;
+        std::size_t m_start = 0;
+    };
+
+    using table_t = std::array<bool, 256>;
+
+    table_t make_table(std::span<const std::byte> set) noexcept
+    {
+        table_t table{};
+
+        for (auto value : set)
+        {
+            table.at(std::to_integer<std::size_t>(value)) = true;
+        }
+
+        return table;
+    }
+
+    // Scalar kernels: the portable fallback, and the tail loop for the
+    // vector kernels.
+    std::size_t find_byte_scalar(const std::byte* data, std::size_t length, std::byte value) noexcept
+    {
+        if (length == 0)
+        {
+            return scan::npos;
+        }
+
+        const auto* found = static_cast<const std::byte*>(std::memchr(data, std::to_integer<int>(value), length));
+        return found ? static_cast<std::size_t>(found - data) : scan::npos;
+    }
+
+    std::size_t find_any_scalar(const std::byte* data, std::size_t length, std::span<const std::byte> set) noexcept
+    {
+        auto table = make_table(set);
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (table.at(std::to_integer<std::size_t>(data[i])))
+            {
+                return i;
+            }
+        }
+
+        return scan::npos;
+    }
+
+    std::size_t count_byte_scalar(const std::byte* data, std::size_t length, std::byte value) noexcept
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            count += data[i] == value ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    std::size_t split_scalar(const std::byte* data, std::size_t length, std::byte value, std::span<field_t> fields) noexcept
+    {
+        splitter_t splitter(data, length, fields);
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (data[i] == value && !splitter.emit(i))
+            {
+                break;
+            }
+        }
+
+        return splitter.finish();
+    }
+
+#if defined(SCAN_X86)
+    constexpr std::size_t max_vector_set = 16;
+
+    // SSE2 kernels: 16 bytes per step, always available on x86-64.
+    __attribute__((target("sse2"))) std::size_t find_byte_sse2(const std::byte* data, std::size_t length, std::byte value) noexcept
+    {
+        auto needle = _mm_set1_epi8(std::to_integer<char>(value));
+        std::size_t i = 0;
+
+        for (; i + 16 <= length; i += 16)
+        {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+            if (mask != 0)
+            {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+
+        auto rest = find_byte_scalar(data + i, length - i, value);
+        return rest == scan::npos ? rest : i + rest;
+    }
+
+    __attribute__((target("sse2"))) std::size_t find_any_sse2(const std::byte* data, std::size_t length, std::span<const std::byte> set) noexcept
+    {
+        if (set.size() > max_vector_set)
+        {
+            return find_any_scalar(data, length, set);
+        }
+
+        __m128i needles[max_vector_set];
+
+        for (std::size_t k = 0; k < set.size(); ++k)
+        {
+            needles[k] = _mm_set1_epi8(std::to_integer<char>(set[k]));
+        }
+
+        std::size_t i = 0;
+
+        for (; i + 16 <= length; i += 16)
+        {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            auto matches = _mm_setzero_si128();
+
+            for (std::size_t k = 0; k < set.size(); ++k)
+            {
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[k]));
+            }
+
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+
+            if (mask != 0)
+            {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+
+        auto rest = find_any_scalar(data + i, length - i, set);
+        return rest == scan::npos ? rest : i + rest;
+    }
+
+    __attribute__((target("sse2"))) std::size_t count_byte_sse2(const std::byte* data, std::size_t length, std::byte value) noexcept
+    {
+        auto needle = _mm_set1_epi8(std::to_integer<char>(value));
+
+        std::size_t count = 0;
+        std::size_t i = 0;
+
+        for (; i + 16 <= length; i += 16)
+        {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+            count += static_cast<std::size_t>(std::popcount(mask));
+        }
+
+        return count + count_byte_scalar(data + i, length - i, value);
+    }
+
+    __attribute__((target("sse2"))) std::size_t split_sse2(const std::byte* data, std::size_t length, std::byte value, std::span<field_t> fields) noexcept
+    {
+        splitter_t splitter(data, length, fields);
+        auto needle = _mm_set1_epi8(std::to_integer<char>(value));
+
+        std::size_t i = 0;
+
+        for (; i + 16 <= length; i += 16)
+        {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+            for (; mask != 0; mask &= mask - 1)
+            {
+                if (!splitter.emit(i + static_cast<std::size_t>(std::countr_zero(mask))))
+                {
+                    return splitter.finish();
+                }
+            }
+        }
+
+        for (; i < length; ++i)
+        {
+            if (data[i] == value && !splitter.emit(i))
+            {
+                break;
+            }
+        }
+
+        return splitter.finish();
+    }
+
+    // AVX2 kernels: same shape as SSE2, 32 bytes per step.
+    __attribute__((target("avx2"))) std::size_t find_byte_avx2(const std::byte* data, std::size_t length, std::byte value) noexcept
+    {
+        auto needle = _mm256_set1_epi8(std::to_integer<char>(value));
+        std::size_t i = 0;
+
+        for (; i + 32 <= length; i += 32)
+        {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+
+            if (mask != 0)
+            {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+
+        auto rest = find_byte_sse2(data + i, length - i, value);
+        return rest == scan::npos ? rest : i + rest;
+    }
+
+    __attribute__((target("avx2"))) std::size_t find_any_avx2(const std::byte* data, std::size_t length, std::span<const std::byte> set) noexcept
+    {
+        if (set.size() > max_vector_set)
+        {
+            return find_any_scalar(data, length, set);
+        }
+
+        __m256i needles[max_vector_set];
+
+        for (std::size_t k = 0; k < set.size(); ++k)
+        {
+            needles[k] = _mm256_set1_epi8(std::to_integer<char>(set[k]));
+        }
+
+        std::size_t i = 0;
+
+        for (; i + 32 <= length; i += 32)
+        {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            auto matches = _mm256_setzero_si256();
+
+            for (std::size_t k = 0; k < set.size(); ++k)
+            {
+                matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[k]));
+            }
+
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(matches));
+
+            if (mask != 0)
+            {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+
+        auto rest = find_any_sse2(data + i, length - i, set);
+        return rest == scan::npos ? rest : i + rest;
+    }
+
+    __attribute__((target("avx2"))) std::size_t count_byte_avx2(const std::byte* data, std::size_t length, std::byte value) noexcept
+    {
+        auto needle = _mm256_set1_epi8(std::to_integer<char>(value));
+
+        std::size_t count = 0;
+        std::size_t i = 0;
+
+        for (; i + 32 <= length; i += 32)
+        {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+
+            count += static_cast<std::size_t>(std::popcount(mask));
+        }
+
+        return count + count_byte_sse2(data + i, length - i, value);
+    }
+
+    __attribute__((target("avx2"))) std::size_t split_avx2(const std::byte* data, std::size_t length, std::byte value, std::span<field_t> fields) noexcept
+    {
+        splitter_t splitter(data, length, fields);
+        auto needle = _mm256_set1_epi8(std::to_integer<char>(value));
+
+        std::size_t i = 0;
+
+        for (; i + 32 <= length; i += 32)
+        {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+
+            for (; mask != 0; mask &= mask - 1)
+            {
+                if (!splitter.emit(i + static_cast<std::size_t>(std::countr_zero(mask))))
+                {
+                    return splitter.finish();
+                }
+            }
+        }
+
+        for (; i < length; ++i)
+        {
+            if (data[i] == value && !splitter.emit(i))
+            {
+                break;
+            }
+        }
+
+        return splitter.finish();
+    }
+#endif
+
+    struct kernels_t
+    {
+        scan::isa_t isa;
+
+        std::size_t (*find_byte)(const std::byte*, std::size_t, std::byte) noexcept;
+        std::size_t (*find_any)(const std::byte*, std::size_t, std::span<const std::byte>) noexcept;
+        std::size_t (*count_byte)(const std::byte*, std::size_t, std::byte) noexcept;
+        std::size_t (*split)(const std::byte*, std::size_t, std::byte, std::span<field_t>) noexcept;
+    };
+
+    constexpr kernels_t scalar_kernels{scan::isa_t::scalar, find_byte_scalar, find_any_scalar, count_byte_scalar, split_scalar};
+
+#if defined(SCAN_X86)
+    constexpr kernels_t sse2_kernels{scan::isa_t::sse2, find_byte_sse2, find_any_sse2, count_byte_sse2, split_sse2};
+    constexpr kernels_t avx2_kernels{scan::isa_t::avx2, find_byte_avx2, find_any_avx2, count_byte_avx2, split_avx2};
+#endif
+
+    bool supported(scan::isa_t isa) noexcept
+    {
+        switch (isa)
+        {
+#if defined(SCAN_X86)
+            case scan::isa_t::avx2:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+
+            case scan::isa_t::sse2:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("sse2");
+#endif
+            case scan::isa_t::scalar:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    const kernels_t* table_for(scan::isa_t isa) noexcept
+    {
+        switch (isa)
+        {
+#if defined(SCAN_X86)
+            case scan::isa_t::avx2:
+                return &avx2_kernels;
+
+            case scan::isa_t::sse2:
+                return &sse2_kernels;
+#endif
+            default:
+                return &scalar_kernels;
+        }
+    }
+
+    const kernels_t* select() noexcept
+    {
+        for (auto isa : {scan::isa_t::avx2, scan::isa_t::sse2})
+        {
+            if (supported(isa))
+            {
+                return table_for(isa);
+            }
+        }
+
+        return &scalar_kernels;
+    }
+
+    // Constant-initialised, so it is usable from other static initialisers;
+    // null until the first scan resolves it from CPUID.
+    constinit std::atomic<const kernels_t*> kernels{nullptr};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    const kernels_t* current() noexcept
+    {
+        const auto* table = kernels.load(std::memory_order_acquire);
+
+        if (table == nullptr) [[unlikely]]
+        {
+            // A concurrent force() wins over the default choice; on failure
+            // the exchange leaves its table in expected.
+            const kernels_t* expected = nullptr;
+            table = select();
+
+            if (!kernels.compare_exchange_strong(expected, table, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                table = expected;
+            }
+        }
+
+        return table;
+    }
+}  // namespace
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-constant-array-index, cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays, cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+
+/*****************************************************************************/
+/*** FREE FUNCTIONS **********************************************************/
+
+namespace scan
+{
+    std::size_t find_byte(std::span<const std::byte> data, std::byte value) noexcept
+    {
+        return current()->find_byte(data.data(), data.size(), value);
+    }
+
+    std::size_t find_any(std::span<const std::byte> data, std::span<const std::byte> set) noexcept
+    {
+        if (set.empty())
+        {
+            return npos;
+        }
+
+        return current()->find_any(data.data(), data.size(), set);
+    }
+
+    std::size_t count_byte(std::span<const std::byte> data, std::byte value) noexcept
+    {
+        return current()->count_byte(data.data(), data.size(), value);
+    }
+
+    std::size_t split(std::span<const std::byte> data, std::byte delimiter, std::span<field_t> fields) noexcept
+    {
+        if (fields.empty())
+        {
+            return 0;
+        }
+
+        if (fields.size() == 1)
+        {
+            fields.front() = data;
+            return 1;
+        }
+
+        return current()->split(data.data(), data.size(), delimiter, fields);
+    }
+
+    isa_t active() noexcept
+    {
+        return current()->isa;
+    }
+
+    bool force(isa_t isa) noexcept
+    {
+        if (!supported(isa))
+        {
+            return false;
+        }
+
+        kernels.store(table_for(isa), std::memory_order_release);
+        return true;
+    }
+}  // namespace scan
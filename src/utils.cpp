@@ -2,10 +2,10 @@
 /*** HEADER INCLUDES *********************************************************/
 
 #include "utils.hpp"
+#include "crash.hpp"
 
 /// \cond
-#include <exception>
-#include <iostream>
+#include <cstdlib>
 
 /// \endcond
 
@@ -14,10 +14,7 @@
 
 void annotate_and_terminate(const char* message, const char* file, int line)
 {
-    std::cout << "Program panicked with\n"
-              << "  " << message << '\n'
-              << "On File: " << file << '\n'
-              << "At Line: " << line << '\n';
-
-    std::terminate();
+    // abort() hands over to the crash handler for the backtrace and log flush.
+    crash::annotate(message, file, line);
+    std::abort();
 }
@@ -0,0 +1,142 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "admin_shell.hpp"
+
+/// \cond
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    std::string socket_path(std::string_view test)
+    {
+        return "/tmp/toolbox-admin-" + std::string(test) + "-" + std::to_string(::getpid()) + ".sock";
+    }
+
+    // Everything the shell sends until it closes the connection.
+    std::string read_all(const socket_t& client)
+    {
+        std::string received;
+        std::array<char, 4096> buffer{};
+
+        while (auto length = client.recv(buffer.data(), buffer.size()))
+        {
+            if (length.value() == 0)
+            {
+                break;
+            }
+
+            received.append(buffer.data(), length.value());
+        }
+
+        return received;
+    }
+}  // namespace
+
+TEST_CASE("Admin shell serves commands over a Unix socket")
+{
+    command_registry_t registry;
+
+    registry.add("depth", "queue depths", [](std::span<const std::string_view> /* arguments */, const auto& output) {
+        output("orders 3");
+        output("fills 0");
+    });
+
+    auto path = socket_path("serve");
+    auto endpoint = endpoint_t::local(path);
+    REQUIRE(endpoint);
+
+    admin_shell_t shell(registry);
+    REQUIRE(shell.start(*endpoint));
+
+    socket_t client(AF_UNIX);
+    REQUIRE(client.connect(*endpoint));
+    REQUIRE(client.send("depth\nquit\n"));
+
+    REQUIRE(read_all(client) == "> orders 3\nfills 0\n> ");
+
+    shell.stop();
+    REQUIRE(::access(path.c_str(), F_OK) != 0);
+}
+
+TEST_CASE("Admin shell does not block on a client that stops reading")
+{
+    command_registry_t registry;
+
+    // Far more than the socket buffer and the shell's output queue hold.
+    registry.add("dump", "large output", [](std::span<const std::string_view> /* arguments */, const auto& output) {
+        std::string line(1024, 'x');
+
+        for (int i = 0; i < 4096; ++i)
+        {
+            output(line);
+        }
+    });
+
+    auto endpoint = endpoint_t::local(socket_path("slow"));
+    REQUIRE(endpoint);
+
+    admin_shell_t shell(registry);
+    REQUIRE(shell.start(*endpoint));
+
+    socket_t client(AF_UNIX);
+    REQUIRE(client.connect(*endpoint));
+    REQUIRE(client.send("dump\n"));
+
+    // Nothing is read while the shell produces the dump.
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto started = std::chrono::steady_clock::now();
+    shell.stop();
+
+    REQUIRE(std::chrono::steady_clock::now() - started < std::chrono::seconds(2));
+
+    // Over the output cap the client was cut off, not served in full.
+    REQUIRE(read_all(client).size() < 4096U * 1025U);
+}
+
+TEST_CASE("Admin shell disconnects a client sending an endless line")
+{
+    command_registry_t registry;
+
+    auto endpoint = endpoint_t::local(socket_path("long"));
+    REQUIRE(endpoint);
+
+    admin_shell_t shell(registry);
+    REQUIRE(shell.start(*endpoint));
+
+    socket_t client(AF_UNIX);
+    REQUIRE(client.connect(*endpoint));
+
+    // No newline: the shell gives up once the pending input passes its cap.
+    std::string line(128 * 1024, 'a');
+    std::string_view rest(line);
+
+    while (!rest.empty())
+    {
+        auto sent = client.send(rest);
+
+        if (!sent)
+        {
+            break;
+        }
+
+        rest.remove_prefix(sent.value());
+    }
+
+    REQUIRE(read_all(client) == "> ");
+}
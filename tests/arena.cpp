@@ -0,0 +1,76 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "arena.hpp"
+
+/// \cond
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Arena honours alignment")
+{
+    arena_t arena(256);
+
+    std::ignore = arena.allocate(1, 1);
+    auto* aligned = arena.allocate(8, 64);
+
+    REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+}
+
+TEST_CASE("Arena reuses blocks after reset")
+{
+    arena_t arena(128);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        std::ignore = arena.allocate(64);
+    }
+
+    auto reserved = arena.reserved();
+    arena.reset();
+
+    REQUIRE(arena.used() == 0);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        std::ignore = arena.allocate(64);
+    }
+
+    REQUIRE(arena.reserved() == reserved);
+}
+
+TEST_CASE("Arena serves oversized requests")
+{
+    arena_t arena(64);
+
+    auto* memory = static_cast<char*>(arena.allocate(1024));
+    memory[1023] = 'x';
+
+    REQUIRE(arena.reserved() >= 1024);
+}
+
+TEST_CASE("Arena backs pmr containers")
+{
+    arena_t arena;
+    arena_resource_t resource(arena);
+
+    std::pmr::vector<std::pmr::string> items(&resource);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        items.emplace_back("a string that does not fit in the small buffer");
+    }
+
+    REQUIRE(items.size() == 100);
+    REQUIRE(arena.used() > 0);
+}
@@ -0,0 +1,105 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "buffer_chain.hpp"
+
+/// \cond
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::span<const std::byte> bytes(std::string_view text)
+{
+    return std::as_bytes(std::span(text));
+}
+
+static std::string text(const buffer_chain_t& chain)
+{
+    std::string result(chain.size(), '\0');
+    std::ignore = chain.copy_to(std::as_writable_bytes(std::span(result)));
+
+    return result;
+}
+
+TEST_CASE("Chain spans multiple slabs")
+{
+    buffer_chain_t chain;
+    std::string payload(buffer_chain_t::slab_capacity * 2 + 10, 'x');
+
+    chain.append(bytes(payload));
+
+    REQUIRE(chain.size() == payload.size());
+    REQUIRE(chain.segments().size() == 3);
+    REQUIRE(text(chain) == payload);
+}
+
+TEST_CASE("Slices share slabs")
+{
+    buffer_chain_t chain;
+    chain.append(bytes("header:payload"));
+
+    auto slice = chain.slice(7, 7);
+
+    REQUIRE(text(slice) == "payload");
+    REQUIRE(slice.segments()[0].data().data() == chain.segments()[0].data().data() + 7);
+}
+
+TEST_CASE("Shared slabs are never written")
+{
+    buffer_chain_t chain;
+    chain.append(bytes("abc"));
+
+    auto copy = chain;
+    chain.append(bytes("def"));
+
+    REQUIRE(text(copy) == "abc");
+    REQUIRE(text(chain) == "abcdef");
+    REQUIRE(chain.segments().size() == 2);
+}
+
+TEST_CASE("Prepend reuses headroom")
+{
+    buffer_chain_t chain;
+    chain.append(bytes("body"));
+
+    chain.prepend(bytes("2:"));
+    chain.prepend(bytes("1:"));
+
+    REQUIRE(text(chain) == "1:2:body");
+    REQUIRE(chain.segments().size() == 2);
+}
+
+TEST_CASE("Consume drops leading bytes")
+{
+    buffer_chain_t chain;
+    std::string payload(buffer_chain_t::slab_capacity + 5, 'y');
+
+    chain.append(bytes(payload));
+    chain.consume(buffer_chain_t::slab_capacity + 2);
+
+    REQUIRE(chain.size() == 3);
+    REQUIRE(chain.segments().size() == 1);
+}
+
+TEST_CASE("Chain carves slabs from a caller's pool")
+{
+    pool_t pool(buffer_chain_t::slab_size);
+
+    buffer_chain_t chain(pool);
+    std::string payload(buffer_chain_t::slab_capacity + 10, 'p');
+
+    chain.append(bytes(payload));
+
+    REQUIRE(chain.segments().size() == 2);
+    REQUIRE(text(chain) == payload);
+    REQUIRE(pool.stats().allocations == 2);
+}
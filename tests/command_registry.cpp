@@ -0,0 +1,82 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "command_registry.hpp"
+
+/// \cond
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Registry dispatches by the first word")
+{
+    command_registry_t registry;
+    std::vector<std::string> lines;
+
+    registry.add("echo", "print the arguments", [](std::span<const std::string_view> arguments, const auto& output) {
+        for (auto argument : arguments)
+        {
+            output(argument);
+        }
+    });
+
+    auto output = [&lines](std::string_view line) { lines.emplace_back(line); };
+
+    REQUIRE(registry.execute("  echo a\tbc  ", output));
+    REQUIRE(lines == std::vector<std::string>{"a", "bc"});
+
+    lines.clear();
+
+    REQUIRE_FALSE(registry.execute("   ", output));
+    REQUIRE(lines.empty());
+
+    REQUIRE_FALSE(registry.execute("nope", output));
+    REQUIRE(lines == std::vector<std::string>{"unknown command: nope"});
+
+    lines.clear();
+
+    REQUIRE(registry.execute("help", output));
+    REQUIRE(lines == std::vector<std::string>{"echo - print the arguments"});
+}
+
+TEST_CASE("Registry completes names and arguments")
+{
+    command_registry_t registry;
+
+    auto nothing = [](std::span<const std::string_view> /* arguments */, const auto& /* output */) {};
+
+    registry.add("stats", "", nothing, [](std::span<const std::string_view> /* arguments */) {
+        return std::vector<std::string>{"queues", "histograms"};
+    });
+    registry.add("stop", "", nothing);
+    registry.add("quit", "", nothing);
+
+    REQUIRE(registry.complete("st") == std::vector<std::string>{"stats", "stop"});
+    REQUIRE(registry.complete("").size() == 3);
+    REQUIRE(registry.complete("stats q") == std::vector<std::string>{"queues"});
+    REQUIRE(registry.complete("stats ").size() == 2);
+    REQUIRE(registry.complete("stop ").empty());
+}
+
+TEST_CASE("Registry imports a command table")
+{
+    static constexpr command_table_t table(std::array{
+        command_t{"ping", "reply", [](std::span<const std::string_view> /* arguments */, const command_t::output_t& output) { output("pong"); }},
+    });
+
+    command_registry_t registry;
+    registry.add(table);
+
+    std::vector<std::string> lines;
+    REQUIRE(registry.execute("ping", [&lines](std::string_view line) { lines.emplace_back(line); }));
+    REQUIRE(lines == std::vector<std::string>{"pong"});
+}
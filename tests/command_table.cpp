@@ -0,0 +1,148 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "command_table.hpp"
+
+/// \cond
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static void echo(std::span<const std::string_view> arguments, const command_t::output_t& output)
+{
+    for (auto argument : arguments)
+    {
+        output(argument);
+    }
+}
+
+static void count(std::span<const std::string_view> arguments, const command_t::output_t& output)
+{
+    output(std::to_string(arguments.size()));
+}
+
+static std::vector<std::string> queues(std::span<const std::string_view> /* arguments */)
+{
+    return {"orders", "fills", "cancels"};
+}
+
+static constexpr std::array engine{
+    command_t{"stats", "dump statistics", &count, &queues},
+    command_t{"stop", "stop the engine", &count},
+    command_t{"echo", "print the arguments", &echo},
+};
+
+static constexpr command_table_t commands(engine, true);
+
+static constexpr command_table_t exact(std::array{
+    command_t{"stats", "dump statistics", &count},
+    command_t{"echo", "print the arguments", &echo},
+});
+
+static_assert(commands.find("echo") != nullptr);
+static_assert(commands.find("e") == commands.find("echo"));
+static_assert(commands.find("st") == nullptr);
+static_assert(commands.find("sta")->name == "stats");
+static_assert(commands.find("echoes") == nullptr);
+
+static_assert(exact.find("echo") != nullptr);
+static_assert(exact.find("e") == nullptr);
+static_assert(exact.find("stat") == nullptr);
+
+TEST_CASE("Tokens are views into the line")
+{
+    constexpr std::string_view line = "  set\tlimit  10 ";
+    tokens_t tokens(line);
+
+    REQUIRE(tokens.size() == 3);
+    REQUIRE(tokens.front() == "set");
+    REQUIRE(tokens.back() == "10");
+    REQUIRE(tokens.arguments().size() == 2);
+    REQUIRE(tokens.front().data() == line.data() + 2);
+
+    REQUIRE(tokens_t(" \t ").empty());
+
+    std::string many;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        many += "w" + std::to_string(i) + ' ';
+    }
+
+    tokens_t capped(many);
+
+    REQUIRE(capped.size() == tokens_t::max_tokens);
+    REQUIRE(capped.back() == "w15 w16 w17 w18 w19");
+}
+
+TEST_CASE("Table dispatches full and abbreviated names")
+{
+    std::vector<std::string> lines;
+    auto output = [&lines](std::string_view line) { lines.emplace_back(line); };
+
+    REQUIRE(commands.execute("echo a b", output));
+    REQUIRE(commands.execute("sta x y z", output));
+    REQUIRE(lines == std::vector<std::string>{"a", "b", "3"});
+
+    lines.clear();
+
+    REQUIRE_FALSE(commands.execute("st", output));
+    REQUIRE_FALSE(commands.execute("", output));
+    REQUIRE(lines == std::vector<std::string>{"unknown command: st"});
+
+    lines.clear();
+
+    REQUIRE(commands.execute("help", output));
+    REQUIRE(lines.size() == 3);
+}
+
+TEST_CASE("Table without abbreviations matches whole names only")
+{
+    std::vector<std::string> lines;
+    auto output = [&lines](std::string_view line) { lines.emplace_back(line); };
+
+    // Same rule as command_registry_t, so a line behaves alike on either.
+    REQUIRE(exact.execute("echo a", output));
+    REQUIRE_FALSE(exact.execute("ec a", output));
+    REQUIRE(lines == std::vector<std::string>{"a", "unknown command: ec"});
+
+    REQUIRE(exact.complete("st") == std::vector<std::string>{"stats"});
+}
+
+TEST_CASE("Table lists itself for help even when a name extends it")
+{
+    static constexpr command_table_t helpers(std::array{
+        command_t{"helper", "not the listing", &count},
+        command_t{"echo", "print the arguments", &echo},
+    });
+
+    std::vector<std::string> lines;
+    auto output = [&lines](std::string_view line) { lines.emplace_back(line); };
+
+    REQUIRE(helpers.execute("help", output));
+    REQUIRE(lines == std::vector<std::string>{"helper - not the listing", "echo - print the arguments"});
+
+    lines.clear();
+
+    REQUIRE(helpers.execute("helper a", output));
+    REQUIRE(lines == std::vector<std::string>{"1"});
+}
+
+TEST_CASE("Table completes names in order and arguments")
+{
+    REQUIRE(commands.complete("") == std::vector<std::string>{"echo", "stats", "stop"});
+    REQUIRE(commands.complete("st") == std::vector<std::string>{"stats", "stop"});
+    REQUIRE(commands.complete("x").empty());
+    REQUIRE(commands.complete("stats ").size() == 3);
+    REQUIRE(commands.complete("stats f") == std::vector<std::string>{"fills"});
+    REQUIRE(commands.complete("stop ").empty());
+}
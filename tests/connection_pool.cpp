@@ -0,0 +1,213 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "connection_pool.hpp"
+
+/// \cond
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    // A listening Unix socket; connections queue in its backlog until
+    // accepted.
+    struct listener_t
+    {
+        explicit listener_t(const std::string& name)
+            : path("/tmp/toolbox-" + name + "-" + std::to_string(::getpid()) + ".sock")
+            , endpoint(*endpoint_t::local(path))
+            , socket(AF_UNIX)
+        {
+            ::unlink(path.c_str());
+
+            REQUIRE(socket.bind(endpoint));
+            REQUIRE(socket.listen());
+        }
+
+        listener_t(const listener_t& /* that */) = delete;
+        listener_t(listener_t&& /* that */) = delete;
+
+        ~listener_t()
+        {
+            ::unlink(path.c_str());
+        }
+
+        listener_t& operator=(const listener_t& /* that */) = delete;
+        listener_t& operator=(listener_t&& /* that */) = delete;
+
+        std::string path;
+        endpoint_t endpoint;
+        socket_t socket;
+    };
+}  // namespace
+
+TEST_CASE("Connection pool reuses released connections")
+{
+    listener_t listener("pool-reuse");
+    connection_pool_t pool;
+
+    auto descriptor = decltype(std::declval<socket_t>().descriptor()){};
+
+    {
+        auto lease = pool.acquire(listener.endpoint);
+        REQUIRE(lease);
+
+        descriptor = lease.value()->descriptor();
+    }
+
+    REQUIRE(pool.idle(listener.endpoint) == 1);
+
+    auto lease = pool.acquire(listener.endpoint);
+    REQUIRE(lease);
+    REQUIRE(lease.value()->descriptor() == descriptor);
+    REQUIRE(pool.idle(listener.endpoint) == 0);
+
+    // Discarded leases are closed instead of returning to the pool.
+    lease.value().discard();
+    lease.value() = {};
+
+    REQUIRE(pool.idle(listener.endpoint) == 0);
+}
+
+TEST_CASE("Connection pool evicts idle connections the peer closed")
+{
+    listener_t listener("pool-evict");
+    connection_pool_t pool;
+
+    {
+        auto lease = pool.acquire(listener.endpoint);
+        REQUIRE(lease);
+    }
+
+    auto accepted = listener.socket.accept();
+    REQUIRE(accepted);
+    accepted.value().close();
+
+    REQUIRE(pool.idle(listener.endpoint) == 1);
+    pool.prune();
+    REQUIRE(pool.idle(listener.endpoint) == 0);
+
+    // The next lease is a fresh connection.
+    auto lease = pool.acquire(listener.endpoint);
+    REQUIRE(lease);
+    REQUIRE(listener.socket.accept());
+}
+
+TEST_CASE("Connection pool makes callers wait once exhausted")
+{
+    listener_t listener("pool-wait");
+    connection_pool_t pool({.max_connections = 1});
+
+    auto first = pool.acquire(listener.endpoint);
+    REQUIRE(first);
+
+    std::atomic<bool> served{false};
+
+    std::thread waiter([&] {
+        auto second = pool.acquire(listener.endpoint);
+        served = static_cast<bool>(second);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(served);
+
+    first.value() = {};
+    waiter.join();
+
+    REQUIRE(served);
+}
+
+TEST_CASE("Connection pool gives up after the acquire timeout")
+{
+    listener_t listener("pool-timeout");
+    connection_pool_t pool({.max_connections = 1, .acquire_timeout = std::chrono::milliseconds(50)});
+
+    auto first = pool.acquire(listener.endpoint);
+    REQUIRE(first);
+
+    auto started = std::chrono::steady_clock::now();
+    auto second = pool.acquire(listener.endpoint);
+
+    REQUIRE_FALSE(second);
+    REQUIRE(second.error() == std::errc::timed_out);
+    REQUIRE(std::chrono::steady_clock::now() - started >= std::chrono::milliseconds(50));
+
+    // The abandoned turn does not hold up the callers behind it.
+    first.value() = {};
+
+    auto third = pool.acquire(listener.endpoint);
+    REQUIRE(third);
+}
+
+TEST_CASE("Connection pool reports why it could not connect")
+{
+    connection_pool_t pool;
+
+    auto invalid = pool.acquire("not an address", 80);
+
+    REQUIRE_FALSE(invalid);
+    REQUIRE(invalid.error() == std::errc::invalid_argument);
+
+    // Nothing listens on this path.
+    auto missing = pool.acquire(*endpoint_t::local("/tmp/toolbox-pool-missing-" + std::to_string(::getpid()) + ".sock"));
+
+    REQUIRE_FALSE(missing);
+    REQUIRE(missing.error() == std::errc::no_such_file_or_directory);
+}
+
+TEST_CASE("Connection pool gives up after the connect timeout")
+{
+    socket_t listener;
+
+    REQUIRE(listener.bind(*endpoint_t::parse("127.0.0.1", 0)));
+    REQUIRE(listener.listen(0));
+
+    auto endpoint = listener.local_endpoint();
+    REQUIRE(endpoint);
+
+    // Nothing is accepted: once the backlog is full, the kernel drops SYNs
+    // and further connects stay pending.
+    std::vector<socket_t> fillers;
+    auto full = false;
+
+    for (int i = 0; i < 16 && !full; ++i)
+    {
+        auto& filler = fillers.emplace_back();
+        auto status = filler.connect(endpoint.value(), std::chrono::milliseconds(100));
+
+        if (!status)
+        {
+            REQUIRE(status.error() == std::errc::timed_out);
+
+            // The failed socket is blocking again, as after connect().
+            REQUIRE((::fcntl(filler.descriptor(), F_GETFL) & O_NONBLOCK) == 0);
+            full = true;
+        }
+    }
+
+    REQUIRE(full);
+
+    connection_pool_t pool({.connect_timeout = std::chrono::milliseconds(100)});
+
+    auto started = std::chrono::steady_clock::now();
+    auto lease = pool.acquire(endpoint.value());
+
+    REQUIRE_FALSE(lease);
+    REQUIRE(lease.error() == std::errc::timed_out);
+    REQUIRE(std::chrono::steady_clock::now() - started < std::chrono::seconds(2));
+}
@@ -0,0 +1,126 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "crash.hpp"
+#include "thread.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static void mark(int descriptor)
+{
+    constexpr std::string_view text = "hook ran\n";
+    std::ignore = ::write(descriptor, text.data(), text.size());
+}
+
+static void hang(int /* descriptor */)
+{
+    while (true)
+    {
+        ::pause();
+    }
+}
+
+// Runs fn in a child with the handler installed; returns the crash file.
+template <typename F>
+static std::string crash_child(int expected, F&& fn, unsigned hook_timeout = 5)
+{
+    auto file = "/tmp/toolbox-crash-" + std::to_string(::getpid()) + ".log";
+    ::unlink(file.c_str());
+
+    auto child = ::fork();
+    REQUIRE(child >= 0);
+
+    if (child == 0)
+    {
+        if (!crash::install({file.c_str(), true, hook_timeout}) || !crash::on_crash(mark))
+        {
+            ::_exit(1);
+        }
+
+        fn();
+        ::_exit(0);
+    }
+
+    int status = 0;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+
+    REQUIRE(WIFSIGNALED(status));
+    REQUIRE(WTERMSIG(status) == expected);
+
+    std::ifstream stream(file);
+    std::string text(std::istreambuf_iterator<char>(stream), {});
+
+    ::unlink(file.c_str());
+    return text;
+}
+
+TEST_CASE("Panics are reported with a backtrace")
+{
+    auto text = crash_child(SIGABRT, [] { panic("out of widgets"); });
+
+    REQUIRE(text.find("Program panicked with\n  out of widgets") != std::string::npos);
+    REQUIRE(text.find("Fatal SIGABRT") != std::string::npos);
+    REQUIRE(text.find("Backtrace:") != std::string::npos);
+    REQUIRE(text.find("Threads:") != std::string::npos);
+    REQUIRE(text.find("hook ran") != std::string::npos);
+}
+
+TEST_CASE("Faults keep their signal")
+{
+    auto text = crash_child(SIGSEGV, [] { ::raise(SIGSEGV); });
+
+    REQUIRE(text.find("Fatal SIGSEGV") != std::string::npos);
+    REQUIRE(text.find("hook ran") != std::string::npos);
+}
+
+TEST_CASE("Hanging hooks still end with the original signal")
+{
+    auto text = crash_child(
+        SIGSEGV,
+        [] {
+            std::ignore = crash::on_crash(hang);
+            ::raise(SIGSEGV);
+        },
+        1);
+
+    REQUIRE(text.find("Fatal SIGSEGV") != std::string::npos);
+    REQUIRE(text.find("hook ran") != std::string::npos);
+    REQUIRE(text.find("Crash hooks timed out") != std::string::npos);
+}
+
+TEST_CASE("Threads started after install get an alternate stack")
+{
+    auto text = crash_child(SIGSEGV, [] {
+        thread_t thread([] {
+            stack_t stack{};
+
+            if (::sigaltstack(nullptr, &stack) != 0 || (stack.ss_flags & SS_DISABLE) != 0)
+            {
+                ::_exit(2);
+            }
+
+            ::raise(SIGSEGV);
+        });
+
+        thread.join();
+    });
+
+    REQUIRE(text.find("Fatal SIGSEGV") != std::string::npos);
+}
@@ -0,0 +1,61 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "endpoint.hpp"
+
+/// \cond
+#include <unordered_set>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("IPv4 endpoints are parsed once")
+{
+    auto endpoint = endpoint_t::parse("127.0.0.1", 8080);
+
+    REQUIRE(endpoint.has_value());
+    REQUIRE(endpoint->family() == AF_INET);
+    REQUIRE(endpoint->port() == 8080);
+    REQUIRE(endpoint->to_string() == "127.0.0.1:8080");
+}
+
+TEST_CASE("IPv6 endpoints accept brackets")
+{
+    auto endpoint = endpoint_t::parse("[::1]", 443);
+
+    REQUIRE(endpoint.has_value());
+    REQUIRE(endpoint->family() == AF_INET6);
+    REQUIRE(endpoint->to_string() == "[::1]:443");
+}
+
+TEST_CASE("Host names are not numeric endpoints")
+{
+    REQUIRE(!endpoint_t::parse("localhost", 80).has_value());
+    REQUIRE(!endpoint_t::parse("300.0.0.1", 80).has_value());
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Unix paths are endpoints")
+{
+    auto endpoint = endpoint_t::local("/tmp/toolbox.sock");
+
+    REQUIRE(endpoint.has_value());
+    REQUIRE(endpoint->family() == AF_UNIX);
+    REQUIRE(endpoint->to_string() == "/tmp/toolbox.sock");
+}
+#endif
+
+TEST_CASE("Endpoints are hashable keys")
+{
+    std::unordered_set<endpoint_t> endpoints;
+
+    endpoints.insert(*endpoint_t::parse("10.0.0.1", 1));
+    endpoints.insert(*endpoint_t::parse("10.0.0.1", 1));
+    endpoints.insert(*endpoint_t::parse("10.0.0.1", 2));
+
+    REQUIRE(endpoints.size() == 2);
+}
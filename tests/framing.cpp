@@ -0,0 +1,113 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "framing.hpp"
+
+/// \cond
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::span<const std::byte> bytes(std::string_view text)
+{
+    return std::as_bytes(std::span(text));
+}
+
+static std::string text(std::span<const std::byte> data)
+{
+    return {reinterpret_cast<const char*>(data.data()), data.size()};
+}
+
+template <typename Protocol>
+static void feed(frame_parser_t<Protocol>& parser, std::span<const std::byte> data)
+{
+    auto buffer = parser.prepare(data.size());
+    std::copy(data.begin(), data.end(), buffer.begin());
+
+    parser.commit(data.size());
+}
+
+template <typename Protocol>
+static std::string encode(const Protocol& protocol, std::string_view payload)
+{
+    buffer_chain_t chain;
+
+    chain.append(bytes(payload));
+    protocol.wrap(chain);
+
+    std::string result(chain.size(), '\0');
+    std::ignore = chain.copy_to(std::as_writable_bytes(std::span(result)));
+
+    return result;
+}
+
+TEST_CASE("Fixed prefix frames survive byte-wise delivery")
+{
+    frame_parser_t<framing::fixed_t> parser;
+    auto wire = encode(framing::fixed_t{}, "hello") + encode(framing::fixed_t{}, "world");
+
+    std::string received;
+
+    for (auto byte : bytes(wire))
+    {
+        feed(parser, std::span(&byte, 1));
+
+        while (auto frame = parser.next())
+        {
+            received += text(*frame);
+        }
+    }
+
+    REQUIRE(received == "helloworld");
+}
+
+TEST_CASE("Varint prefix spans multiple header bytes")
+{
+    frame_parser_t<framing::varint_t> parser;
+    std::string payload(300, 'v');
+
+    auto wire = encode(framing::varint_t{}, payload);
+    REQUIRE(wire.size() == payload.size() + 2);
+
+    feed(parser, bytes(wire));
+
+    auto frame = parser.next();
+
+    REQUIRE(frame.has_value());
+    REQUIRE(text(*frame) == payload);
+    REQUIRE(!parser.next().has_value());
+}
+
+TEST_CASE("Delimited frames are split without copies")
+{
+    frame_parser_t<framing::delimited_t> parser;
+    feed(parser, bytes("first\nsecond\nthi"));
+
+    REQUIRE(text(*parser.next()) == "first");
+    REQUIRE(text(*parser.next()) == "second");
+    REQUIRE(!parser.next().has_value());
+
+    feed(parser, bytes("rd\n"));
+
+    REQUIRE(text(*parser.next()) == "third");
+    REQUIRE(parser.buffered() == 0);
+}
+
+TEST_CASE("Oversized frames fail the parser")
+{
+    frame_parser_t<framing::fixed_t> parser(framing::fixed_t{}, 16);
+    feed(parser, bytes(encode(framing::fixed_t{}, std::string(32, 'x'))));
+
+    REQUIRE(!parser.next().has_value());
+    REQUIRE(parser.failed());
+}
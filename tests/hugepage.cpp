@@ -0,0 +1,98 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "arena.hpp"
+#include "hugepage.hpp"
+#include "pool.hpp"
+
+/// \cond
+#include <cstdint>
+#include <cstring>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Hugepage resource hands out aligned whole pages")
+{
+    hugepage_resource_t resource;
+
+    auto* memory = resource.allocate(100);
+
+    REQUIRE(reinterpret_cast<std::uintptr_t>(memory) % hugepage_resource_t::page_size == 0);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    REQUIRE(resource.stats().transparent_bytes == hugepage_resource_t::page_size);
+
+    std::memset(memory, 0xAB, hugepage_resource_t::page_size);
+    resource.deallocate(memory, 100);
+
+    REQUIRE(resource.stats().transparent_bytes == 0);
+}
+
+TEST_CASE("Hugepage resource falls back when no explicit pages are reserved")
+{
+    hugepage_resource_t::options_t options;
+
+    options.explicit_pages = true;
+    options.lock = true;
+
+    hugepage_resource_t resource(options);
+    auto* memory = resource.allocate(3 * 1024 * 1024);
+
+    auto stats = resource.stats();
+    REQUIRE(stats.explicit_bytes + stats.transparent_bytes == 2 * hugepage_resource_t::page_size);
+
+    resource.deallocate(memory, 3 * 1024 * 1024);
+
+    stats = resource.stats();
+    REQUIRE(stats.explicit_bytes == 0);
+    REQUIRE(stats.transparent_bytes == 0);
+    REQUIRE(stats.locked_bytes == 0);
+}
+
+TEST_CASE("Hugepage resource counts only live regions")
+{
+    hugepage_resource_t::options_t options;
+    options.lock = true;
+
+    hugepage_resource_t resource(options);
+
+    auto* first = resource.allocate(hugepage_resource_t::page_size);
+    auto* second = resource.allocate(2 * hugepage_resource_t::page_size);
+
+    auto stats = resource.stats();
+    REQUIRE(stats.transparent_bytes == 3 * hugepage_resource_t::page_size);
+
+    // Locking may be refused under a low RLIMIT_MEMLOCK, but never counts
+    // more than is mapped.
+    REQUIRE(stats.locked_bytes <= stats.transparent_bytes);
+
+    resource.deallocate(first, hugepage_resource_t::page_size);
+
+    stats = resource.stats();
+    REQUIRE(stats.transparent_bytes == 2 * hugepage_resource_t::page_size);
+    REQUIRE(stats.locked_bytes <= stats.transparent_bytes);
+
+    resource.deallocate(second, 2 * hugepage_resource_t::page_size);
+
+    stats = resource.stats();
+    REQUIRE(stats.transparent_bytes == 0);
+    REQUIRE(stats.locked_bytes == 0);
+}
+
+TEST_CASE("Hugepage resource backs arenas and pools")
+{
+    hugepage_resource_t resource;
+
+    arena_t arena(hugepage_resource_t::page_size / 2, &resource);
+    pool_t pool(64, 64, pool_t::default_chunk_length, &resource);
+
+    REQUIRE(arena.create<int>(42) != nullptr);
+
+    auto* object = pool.allocate();
+    pool.deallocate(object);
+
+    REQUIRE(resource.stats().transparent_bytes == 2 * hugepage_resource_t::page_size);
+}
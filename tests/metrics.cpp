@@ -0,0 +1,142 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "metrics.hpp"
+#include "thread.hpp"
+
+/// \cond
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+// The registry is process-wide, so every test uses names of its own.
+namespace
+{
+    bool contains(const std::string& text, const std::string& line)
+    {
+        return text.find(line + '\n') != std::string::npos;
+    }
+}  // namespace
+
+TEST_CASE("Metrics render counters and gauges")
+{
+    auto requests = metrics::counter("test_requests_total", "Requests served");
+    auto connections = metrics::gauge("test_connections");
+
+    requests.add();
+    requests.add(4);
+
+    connections.set(10);
+    connections.add(-3);
+
+    auto text = metrics::render();
+
+    REQUIRE(contains(text, "# HELP test_requests_total Requests served"));
+    REQUIRE(contains(text, "# TYPE test_requests_total counter"));
+    REQUIRE(contains(text, "test_requests_total 5"));
+    REQUIRE(contains(text, "# TYPE test_connections gauge"));
+    REQUIRE(contains(text, "test_connections 7"));
+
+    // Registering again returns the same metric.
+    metrics::counter("test_requests_total").add();
+    REQUIRE(contains(metrics::render(), "test_requests_total 6"));
+}
+
+TEST_CASE("Metrics bucket histogram observations")
+{
+    auto latency = metrics::histogram("test_latency", {10.0, 1.0, 5.0});
+
+    // Buckets are upper bounds, inclusive.
+    for (auto value : {0.5, 1.0, 3.0, 5.0, 7.0, 100.0})
+    {
+        latency.observe(value);
+    }
+
+    auto text = metrics::render();
+
+    REQUIRE(contains(text, "# TYPE test_latency histogram"));
+    REQUIRE(contains(text, "test_latency_bucket{le=\"1\"} 2"));
+    REQUIRE(contains(text, "test_latency_bucket{le=\"5\"} 4"));
+    REQUIRE(contains(text, "test_latency_bucket{le=\"10\"} 5"));
+    REQUIRE(contains(text, "test_latency_bucket{le=\"+Inf\"} 6"));
+    REQUIRE(contains(text, "test_latency_sum 116.5"));
+    REQUIRE(contains(text, "test_latency_count 6"));
+}
+
+TEST_CASE("Metrics keep histogram bounds while more metrics register")
+{
+    auto sizes = metrics::histogram("test_sizes", {1.0, 2.0});
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::ignore = metrics::counter("test_filler_" + std::to_string(i));
+    }
+
+    sizes.observe(1.5);
+
+    REQUIRE(contains(metrics::render(), "test_sizes_bucket{le=\"2\"} 1"));
+}
+
+TEST_CASE("Metrics sum observations from every thread")
+{
+    auto events = metrics::counter("test_events_total");
+    auto values = metrics::histogram("test_values", {1.0});
+
+    {
+        std::vector<thread_t> threads;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([events, values] {
+                for (int j = 0; j < 1000; ++j)
+                {
+                    events.add();
+                    values.observe(2.0);
+                }
+            });
+        }
+    }
+
+    // Blocks outlive their threads.
+    auto text = metrics::render();
+
+    REQUIRE(contains(text, "test_events_total 4000"));
+    REQUIRE(contains(text, "test_values_bucket{le=\"1\"} 0"));
+    REQUIRE(contains(text, "test_values_count 4000"));
+    REQUIRE(contains(text, "test_values_sum 8000"));
+}
+
+TEST_CASE("Metrics exporter writes the file and stops promptly")
+{
+    auto file = "/tmp/toolbox-metrics-" + std::to_string(::getpid()) + ".prom";
+
+    metrics::counter("test_exported_total").add(3);
+    metrics::start(file, std::chrono::hours(1));
+
+    auto started = std::chrono::steady_clock::now();
+    metrics::stop();
+
+    REQUIRE(std::chrono::steady_clock::now() - started < std::chrono::seconds(5));
+
+    // The exporter writes once more as it stops.
+    std::ifstream stream(file);
+    std::stringstream text;
+    text << stream.rdbuf();
+
+    REQUIRE(contains(text.str(), "test_exported_total 3"));
+
+    ::unlink(file.c_str());
+}
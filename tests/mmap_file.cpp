@@ -0,0 +1,78 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "mmap_file.hpp"
+
+/// \cond
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::string write(std::string_view name, std::string_view content)
+{
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream(path, std::ios::binary) << content;
+
+    return path;
+}
+
+static std::string text(std::span<const std::byte> data)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return {reinterpret_cast<const char*>(data.data()), data.size()};
+}
+
+TEST_CASE("Mapped file exposes its contents")
+{
+    auto path = write("toolbox-mmap-contents", "hello mapped world");
+    auto file = mmap_file_t::open(path, true);
+
+    REQUIRE(file.has_value());
+    REQUIRE(file->size() == 18);
+    REQUIRE(text(file->view(6, 6)) == "mapped");
+    REQUIRE(text(file->view(12, 100)) == " world");
+    REQUIRE(file->advise(mmap_file_t::advice_t::sequential));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Mapped file iterates over lines")
+{
+    auto path = write("toolbox-mmap-lines", "first\n\nthird\nlast");
+    auto file = mmap_file_t::open(path);
+
+    std::vector<std::string> lines;
+
+    for (auto line : file->lines())
+    {
+        lines.push_back(text(line));
+    }
+
+    REQUIRE(lines == std::vector<std::string>{"first", "", "third", "last"});
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Empty and missing files")
+{
+    auto path = write("toolbox-mmap-empty", "");
+    auto file = mmap_file_t::open(path);
+
+    REQUIRE(file.has_value());
+    REQUIRE(file->empty());
+    REQUIRE(file->lines().begin() == std::default_sentinel);
+
+    REQUIRE_FALSE(mmap_file_t::open("/nonexistent/toolbox-mmap").has_value());
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "multiversion.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <numeric>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    // Every clone has to compute the same result as the baseline build.
+    MULTIVERSION int sum(const int* data, std::size_t length) noexcept
+    {
+        int total = 0;
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            total += data[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        return total;
+    }
+}  // namespace
+
+TEST_CASE("Multiversion detects a level the host supports")
+{
+    auto level = multiversion::detect();
+
+    REQUIRE(multiversion::detect() == level);
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+    __builtin_cpu_init();
+
+    // Each level implies the features that define it.
+    if (level >= multiversion::level_t::x86_64_v2)
+    {
+        REQUIRE(__builtin_cpu_supports("sse4.2"));
+        REQUIRE(__builtin_cpu_supports("popcnt"));
+    }
+
+    if (level >= multiversion::level_t::x86_64_v3)
+    {
+        REQUIRE(__builtin_cpu_supports("avx2"));
+        REQUIRE(__builtin_cpu_supports("bmi2"));
+    }
+
+    if (level >= multiversion::level_t::x86_64_v4)
+    {
+        REQUIRE(__builtin_cpu_supports("avx512f"));
+    }
+
+    // And the next level up is genuinely missing.
+    if (level == multiversion::level_t::baseline)
+    {
+        REQUIRE_FALSE(__builtin_cpu_supports("x86-64-v2"));
+    }
+#else
+    REQUIRE(level == multiversion::level_t::baseline);
+#endif
+}
+
+TEST_CASE("Multiversion names every level")
+{
+    REQUIRE(multiversion::name(multiversion::level_t::baseline) == "baseline");
+    REQUIRE(multiversion::name(multiversion::level_t::x86_64_v2) == "x86-64-v2");
+    REQUIRE(multiversion::name(multiversion::level_t::x86_64_v3) == "x86-64-v3");
+    REQUIRE(multiversion::name(multiversion::level_t::x86_64_v4) == "x86-64-v4");
+}
+
+TEST_CASE("Multiversion clones agree with the baseline")
+{
+    std::array<int, 1000> values{};
+    std::iota(values.begin(), values.end(), 1);
+
+    REQUIRE(sum(values.data(), values.size()) == 500500);
+    REQUIRE(sum(values.data(), 7) == 28);
+    REQUIRE(sum(values.data(), 0) == 0);
+}
@@ -0,0 +1,176 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "parallel.hpp"
+
+/// \cond
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Parallel pool runs every task once")
+{
+    parallel_pool_t pool({.threads = 3, .pin = false});
+    REQUIRE(pool.size() == 4);
+
+    std::vector<std::atomic<int>> counts(1000);
+
+    for (int round = 0; round < 50; ++round)
+    {
+        pool.run(counts.size(), [&counts](std::size_t task) { counts[task].fetch_add(1); });
+    }
+
+    for (const auto& count : counts)
+    {
+        REQUIRE(count == 50);
+    }
+}
+
+TEST_CASE("Parallel pool runs nested jobs inline")
+{
+    parallel_pool_t pool({.threads = 2, .pin = false});
+    std::atomic<int> total{0};
+
+    pool.run(8, [&pool, &total](std::size_t /* task */) {
+        pool.run(8, [&total](std::size_t /* task */) { total.fetch_add(1); });
+    });
+
+    REQUIRE(total == 64);
+}
+
+TEST_CASE("Parallel pool rethrows the first exception on the caller")
+{
+    parallel_pool_t pool({.threads = 3, .pin = false});
+    std::atomic<int> started{0};
+
+    // Every task throws, on the caller and the workers alike; only one
+    // exception comes out and the rest of the tasks are skipped.
+    REQUIRE_THROWS_AS(pool.run(1000,
+                               [&started](std::size_t /* task */) {
+                                   started.fetch_add(1);
+                                   throw std::runtime_error("task failed");
+                               }),
+                      std::runtime_error);
+
+    REQUIRE(started >= 1);
+    REQUIRE(started <= 4);
+
+    // The pool is reusable afterwards.
+    std::atomic<int> total{0};
+    pool.run(1000, [&total](std::size_t /* task */) { total.fetch_add(1); });
+
+    REQUIRE(total == 1000);
+
+    // A single throwing task among many still surfaces.
+    REQUIRE_THROWS_AS(pool.run(1000,
+                               [](std::size_t task) {
+                                   if (task == 500)
+                                   {
+                                       throw std::runtime_error("one task failed");
+                                   }
+                               }),
+                      std::runtime_error);
+}
+
+TEST_CASE("Parallel for visits every index and item")
+{
+    parallel_pool_t pool({.threads = 3, .pin = false});
+    parallel_options_t options{.grain = 7, .pool = &pool};
+
+    std::vector<int> values(1000, 0);
+    parallel_for(
+        10,
+        values.size(),
+        [&values](std::size_t i) { values[i] = static_cast<int>(i); },
+        options);
+
+    REQUIRE(values[9] == 0);
+    REQUIRE(values[10] == 10);
+    REQUIRE(values[999] == 999);
+
+    parallel_for(std::span(values), [](int& value) { value *= 2; }, options);
+
+    REQUIRE(values[10] == 20);
+    REQUIRE(values[999] == 1998);
+
+    // Empty ranges do nothing.
+    parallel_for(5, 5, [](std::size_t /* i */) { FAIL(); }, options);
+}
+
+TEST_CASE("Parallel reduce keeps operand order")
+{
+    parallel_pool_t pool({.threads = 3, .pin = false});
+
+    std::vector<std::uint64_t> values(100000);
+    std::iota(values.begin(), values.end(), 1);
+
+    auto sum = parallel_reduce(std::span(values), std::uint64_t{0}, std::plus<>(), {.pool = &pool});
+    REQUIRE(sum == 100000ULL * 100001ULL / 2);
+
+    // Concatenation is associative but not commutative.
+    auto text = parallel_reduce(
+        0,
+        26,
+        std::string(">"),
+        [](std::size_t i) { return std::string(1, static_cast<char>('a' + i)); },
+        std::plus<>(),
+        {.grain = 3, .pool = &pool});
+
+    REQUIRE(text == ">abcdefghijklmnopqrstuvwxyz");
+    REQUIRE(parallel_reduce(3, 3, 42, [](std::size_t /* i */) { return 0; }, std::plus<>()) == 42);
+}
+
+TEST_CASE("Parallel reduce is deterministic across pool sizes")
+{
+    parallel_pool_t small({.threads = 1, .pin = false});
+    parallel_pool_t large({.threads = 5, .pin = false});
+
+    std::vector<double> values(200000);
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = 1.0 / static_cast<double>(i + 1);
+    }
+
+    auto first = parallel_reduce(std::span(values), 0.0, std::plus<>(), {.deterministic = true, .pool = &small});
+    auto second = parallel_reduce(std::span(values), 0.0, std::plus<>(), {.deterministic = true, .pool = &large});
+
+    REQUIRE(first == second);
+}
+
+TEST_CASE("Parallel inclusive scan matches the serial scan")
+{
+    parallel_pool_t pool({.threads = 3, .pin = false});
+
+    std::vector<std::int64_t> input(10007);
+    std::iota(input.begin(), input.end(), -5000);
+
+    std::vector<std::int64_t> expected(input.size());
+    std::inclusive_scan(input.begin(), input.end(), expected.begin());
+
+    for (std::size_t grain : {1UL, 10UL, 4096UL, 20000UL})
+    {
+        std::vector<std::int64_t> output(input.size());
+        parallel_inclusive_scan(std::span(std::as_const(input)), std::span(output), std::plus<>(), {.grain = grain, .pool = &pool});
+
+        REQUIRE(output == expected);
+    }
+
+    // In place.
+    parallel_inclusive_scan(std::span(input), std::span(input), std::plus<>(), {.grain = 100, .pool = &pool});
+    REQUIRE(input == expected);
+}
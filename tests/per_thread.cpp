@@ -0,0 +1,89 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "per_thread.hpp"
+#include "thread.hpp"
+
+/// \cond
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Threads get slots on separate cache lines")
+{
+    per_thread_t<std::atomic<std::uint64_t>> counters;
+    std::vector<std::uintptr_t> addresses(4);
+
+    {
+        std::vector<thread_t> threads;
+
+        for (std::size_t i = 0; i < addresses.size(); ++i)
+        {
+            threads.emplace_back([&counters, &addresses, i] {
+                auto& counter = counters.local();
+                addresses[i] = reinterpret_cast<std::uintptr_t>(&counter);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+                for (int j = 0; j < 1000; ++j)
+                {
+                    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+            });
+        }
+    }
+
+    for (auto address : addresses)
+    {
+        REQUIRE(address % utils::false_sharing_size == 0);
+    }
+
+    std::uint64_t total = 0;
+    counters.for_each([&total](const auto& counter) { total += counter.load(std::memory_order_relaxed); });
+
+    // Slots outlive their threads, so nothing written is lost.
+    REQUIRE(total == 4000);
+}
+
+TEST_CASE("Registry indices are reused after threads exit")
+{
+    std::size_t first = thread_registry::npos;
+    std::size_t second = thread_registry::npos;
+
+    thread_t([&first] { first = thread_registry::index(); }).join();
+    thread_t([&second] { second = thread_registry::index(); }).join();
+
+    REQUIRE(first != thread_registry::npos);
+    REQUIRE(first == second);
+    REQUIRE(first < thread_registry::extent());
+}
+
+TEST_CASE("thread_t registers the thread before running it")
+{
+    auto before = thread_registry::size();
+    std::atomic<bool> release{false};
+    std::atomic<std::size_t> during{0};
+
+    thread_t worker([&] {
+        during = thread_registry::size();
+
+        while (!release)
+        {
+        }
+    });
+
+    while (during == 0)
+    {
+    }
+
+    REQUIRE(during >= before + 1);
+
+    release = true;
+    worker.join();
+}
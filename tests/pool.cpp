@@ -0,0 +1,137 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "pool.hpp"
+#include "socket.hpp"
+
+/// \cond
+#include <algorithm>
+#include <list>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Pool hands out distinct objects")
+{
+    pool_t pool(24);
+
+    std::set<void*> objects;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        objects.insert(pool.allocate());
+    }
+
+    REQUIRE(objects.size() == 1000);
+
+    for (auto* object : objects)
+    {
+        pool.deallocate(object);
+    }
+}
+
+TEST_CASE("Pool recycles released objects")
+{
+    pool_t pool(64);
+
+    auto* first = pool.allocate();
+    pool.deallocate(first);
+
+    REQUIRE(pool.allocate() == first);
+}
+
+TEST_CASE("Pool is shared between threads")
+{
+    pool_t pool(32);
+    std::vector<void*> objects(512);
+
+    std::thread producer([&] {
+        std::generate(objects.begin(), objects.end(), [&] { return pool.allocate(); });
+    });
+
+    producer.join();
+
+    for (auto* object : objects)
+    {
+        pool.deallocate(object);
+    }
+
+    std::sort(objects.begin(), objects.end());
+    REQUIRE(std::adjacent_find(objects.begin(), objects.end()) == objects.end());
+}
+
+TEST_CASE("Pool backs pmr node containers")
+{
+    pool_resource_t resource(64);
+    std::pmr::list<int> items(&resource);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        items.push_back(i);
+    }
+
+    REQUIRE(items.size() == 1000);
+}
+
+TEST_CASE("Pool reports recycling")
+{
+    pool_t pool(48, alignof(std::max_align_t), 64);
+
+    for (int round = 0; round < 100; ++round)
+    {
+        std::vector<void*> objects(100);
+        std::generate(objects.begin(), objects.end(), [&] { return pool.allocate(); });
+
+        for (auto* object : objects)
+        {
+            pool.deallocate(object);
+        }
+    }
+
+    auto stats = pool.stats();
+
+    REQUIRE(stats.allocations == 10000);
+    REQUIRE(stats.carved >= 100);
+    REQUIRE(stats.carved <= 256);
+    REQUIRE(stats.hit_rate() > 0.95);
+}
+
+TEST_CASE("Object pool recycles connection state")
+{
+    struct connection_t
+    {
+        socket_t socket;
+        std::vector<char> buffer = std::vector<char>(64);
+    };
+
+    object_pool_t<connection_t> pool;
+    void* first = nullptr;
+
+    {
+        auto connection = pool.make();
+        REQUIRE(connection->socket.valid());
+
+        first = connection.get();
+    }
+
+    std::vector<object_pool_t<connection_t>::handle_t> connections;
+
+    for (int i = 0; i < 300; ++i)
+    {
+        connections.push_back(pool.make(connection_t{socket_t(AF_UNIX), {}}));
+    }
+
+    REQUIRE(connections.front().get() == first);
+    REQUIRE(std::all_of(connections.begin(), connections.end(), [](const auto& item) { return item->socket.valid(); }));
+
+    connections.clear();
+    REQUIRE(pool.stats().allocations == 301);
+}
@@ -0,0 +1,111 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rcu.hpp"
+#include "thread.hpp"
+
+/// \cond
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    std::atomic<int> live{0};
+
+    struct table_t
+    {
+        table_t()
+        {
+            live += 1;
+        }
+
+        table_t(const table_t& that)
+            : routes(that.routes)
+            , version(that.version)
+        {
+            live += 1;
+        }
+
+        table_t(table_t&& /* that */) = delete;
+
+        ~table_t()
+        {
+            version = -1;
+            live -= 1;
+        }
+
+        table_t& operator=(const table_t& /* that */) = delete;
+        table_t& operator=(table_t&& /* that */) = delete;
+
+        std::map<std::string, int> routes;
+        int version = 0;
+    };
+}  // namespace
+
+TEST_CASE("Readers keep their snapshot across updates")
+{
+    {
+        rcu_t<table_t> table;
+
+        auto before = table.read();
+        table.update([](table_t& next) { next.version = 1; });
+
+        REQUIRE(before->version == 0);
+        REQUIRE(table.read()->version == 1);
+        REQUIRE(live == 2);
+    }
+
+    REQUIRE(live == 0);
+}
+
+TEST_CASE("Old versions are freed once readers are done")
+{
+    rcu_t<table_t> table;
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0};
+
+    std::vector<thread_t> readers;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.emplace_back([&] {
+            while (!done)
+            {
+                auto snapshot = table.read();
+                auto version = snapshot->version;
+
+                // A freed table would read -1 here (and trip the sanitizer).
+                if (version < 0 || snapshot->routes.size() != static_cast<std::size_t>(version))
+                {
+                    bad += 1;
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= 500; ++i)
+    {
+        table.update([i](table_t& next) {
+            next.routes["route" + std::to_string(i)] = i;
+            next.version = i;
+        });
+    }
+
+    done = true;
+    readers.clear();
+
+    REQUIRE(bad == 0);
+
+    table.synchronize();
+    REQUIRE(live == 1);
+}
@@ -0,0 +1,139 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "reactor.hpp"
+
+/// \cond
+#include <unistd.h>
+
+#include <array>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Queue preserves push order")
+{
+    mpsc_queue_t<int> queue;
+
+    REQUIRE(queue.push(1));
+    REQUIRE_FALSE(queue.push(2));
+
+    std::vector<int> values;
+    REQUIRE(queue.drain([&values](int value) { values.push_back(value); }) == 2);
+
+    REQUIRE(values == std::vector<int>{1, 2});
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("Reactor runs tasks posted from other threads")
+{
+    reactor_t reactor;
+    int total = 0;
+
+    std::vector<std::thread> producers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        producers.emplace_back([&reactor, &total] {
+            for (int j = 0; j < 250; ++j)
+            {
+                reactor.post([&total] { total += 1; });
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    reactor.post([&reactor] { reactor.stop(); });
+    reactor.run();
+
+    REQUIRE(total == 1000);
+}
+
+TEST_CASE("Reactor dispatches ready descriptors")
+{
+    reactor_t reactor;
+    std::array<int, 2> pipe{};
+
+    REQUIRE(::pipe(pipe.data()) == 0);
+
+    char received = 0;
+
+    reactor.add(pipe[0], POLLIN, [&](short /* events */) {
+        std::ignore = ::read(pipe[0], &received, 1);
+        reactor.remove(pipe[0]);
+    });
+
+    REQUIRE(reactor.run_once(0) == 0);
+    REQUIRE(::write(pipe[1], "x", 1) == 1);
+    REQUIRE(reactor.run_once(1000) == 1);
+
+    REQUIRE(received == 'x');
+    REQUIRE_FALSE(reactor.watching(pipe[0]));
+
+    ::close(pipe[0]);
+    ::close(pipe[1]);
+}
+
+TEST_CASE("Reactor keeps a stop issued before run")
+{
+    reactor_t reactor;
+
+    // Returns at once instead of blocking in poll() for ever.
+    reactor.stop();
+    reactor.run();
+
+    // The stop was used up: the next run lasts until the next stop.
+    auto ran = false;
+
+    reactor.post([&reactor, &ran] {
+        ran = true;
+        reactor.stop();
+    });
+
+    reactor.run();
+    REQUIRE(ran);
+}
+
+TEST_CASE("Reactor stops when its stop token does")
+{
+    reactor_t reactor;
+
+    std::jthread loop([&reactor](std::stop_token token) { reactor.run(std::move(token)); });
+
+    loop.request_stop();
+    loop.join();
+
+    // A stopped token does not leave the reactor stopped.
+    auto ran = false;
+
+    reactor.post([&reactor, &ran] {
+        ran = true;
+        reactor.stop();
+    });
+
+    reactor.run();
+    REQUIRE(ran);
+}
+
+TEST_CASE("Reactor does not run once stopped before it starts")
+{
+    reactor_t reactor;
+    std::stop_source source;
+
+    source.request_stop();
+    reactor.run(source.get_token());
+
+    REQUIRE(reactor.run_once(0) == 0);
+}
@@ -0,0 +1,179 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "resolver.hpp"
+
+/// \cond
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    // Collects one asynchronous answer and the thread it arrived on.
+    class answer_t
+    {
+    public:
+        [[nodiscard]] resolver_t::callback_t callback()
+        {
+            return [this](std::optional<endpoint_t> endpoint) {
+                std::lock_guard lock(m_mutex);
+
+                m_endpoint = std::move(endpoint);
+                m_thread = std::this_thread::get_id();
+                m_calls += 1;
+
+                m_ready.notify_all();
+            };
+        }
+
+        void wait()
+        {
+            std::unique_lock lock(m_mutex);
+            REQUIRE(m_ready.wait_for(lock, std::chrono::seconds(10), [this] { return m_calls != 0; }));
+        }
+
+        [[nodiscard]] std::optional<endpoint_t> endpoint()
+        {
+            std::lock_guard lock(m_mutex);
+            return m_endpoint;
+        }
+
+        [[nodiscard]] bool on_caller()
+        {
+            std::lock_guard lock(m_mutex);
+            return m_thread == std::this_thread::get_id();
+        }
+
+        [[nodiscard]] std::size_t calls()
+        {
+            std::lock_guard lock(m_mutex);
+            return m_calls;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_ready;
+
+        std::optional<endpoint_t> m_endpoint;
+        std::thread::id m_thread;
+        std::size_t m_calls = 0;
+    };
+
+    // Polls lookup() until the worker has filled the cache.
+    std::optional<endpoint_t> lookup_eventually(resolver_t& resolver, std::string_view host, uint16_t port)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            if (auto endpoint = resolver.lookup(host, port))
+            {
+                return endpoint;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return std::nullopt;
+    }
+}  // namespace
+
+TEST_CASE("Resolver returns literal addresses without a lookup")
+{
+    resolver_t resolver;
+
+    auto endpoint = resolver.lookup("127.0.0.1", 8080);
+    REQUIRE(endpoint);
+    REQUIRE(endpoint->port() == 8080);
+
+    answer_t answer;
+    resolver.resolve("127.0.0.1", 80, answer.callback());
+
+    REQUIRE(answer.calls() == 1);
+    REQUIRE(answer.on_caller());
+}
+
+TEST_CASE("Resolver caches answers and applies the port")
+{
+    resolver_t resolver;
+
+    // The first lookup only queues the query.
+    auto endpoint = lookup_eventually(resolver, "localhost", 443);
+    REQUIRE(endpoint);
+    REQUIRE(endpoint->port() == 443);
+
+    // Cached: answered at once on the calling thread.
+    answer_t answer;
+    resolver.resolve("localhost", 22, answer.callback());
+
+    REQUIRE(answer.calls() == 1);
+    REQUIRE(answer.on_caller());
+    REQUIRE(answer.endpoint()->port() == 22);
+}
+
+TEST_CASE("Resolver refreshes expired entries in the background")
+{
+    resolver_t resolver(std::chrono::milliseconds(0));
+
+    REQUIRE(lookup_eventually(resolver, "localhost", 80));
+
+    // Expired at once, yet still served while the refresh runs.
+    REQUIRE(resolver.lookup("localhost", 80));
+
+    answer_t answer;
+    resolver.resolve("localhost", 80, answer.callback());
+    answer.wait();
+
+    REQUIRE_FALSE(answer.on_caller());
+    REQUIRE(answer.endpoint());
+}
+
+TEST_CASE("Resolver retries failures after the negative TTL")
+{
+    resolver_t resolver(std::chrono::hours(1), std::chrono::milliseconds(0));
+
+    answer_t first;
+    resolver.resolve("does-not-exist.invalid", 80, first.callback());
+    first.wait();
+
+    REQUIRE_FALSE(first.endpoint());
+    REQUIRE_FALSE(first.on_caller());
+
+    // A cached failure would be answered on this thread.
+    answer_t second;
+    resolver.resolve("does-not-exist.invalid", 80, second.callback());
+    second.wait();
+
+    REQUIRE_FALSE(second.on_caller());
+}
+
+TEST_CASE("Resolver answers pending callbacks on shutdown")
+{
+    std::array<answer_t, 4> answers;
+
+    {
+        resolver_t resolver;
+
+        resolver.resolve("localhost", 80, answers[0].callback());
+        resolver.resolve("does-not-exist.invalid", 80, answers[1].callback());
+        resolver.resolve("localhost", 81, answers[2].callback());
+        resolver.resolve("also-missing.invalid", 80, answers[3].callback());
+    }
+
+    for (auto& answer : answers)
+    {
+        REQUIRE(answer.calls() == 1);
+    }
+}
@@ -0,0 +1,57 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "result.hpp"
+
+/// \cond
+#include <string>
+#include <system_error>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static result_t<std::string, std::error_code> lookup(bool found)
+{
+    if (found)
+    {
+        return success_t(std::string("value"));
+    }
+
+    return fail_t(std::make_error_code(std::errc::no_such_file_or_directory));
+}
+
+static result_t<void, std::error_code> check(bool good)
+{
+    if (good)
+    {
+        return {};
+    }
+
+    return fail_t(std::make_error_code(std::errc::invalid_argument));
+}
+
+TEST_CASE("Result exposes the stored value")
+{
+    auto result = lookup(true);
+
+    REQUIRE(result);
+    REQUIRE(result.value() == "value");
+}
+
+TEST_CASE("Result exposes the stored error")
+{
+    auto result = lookup(false);
+
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error() == std::errc::no_such_file_or_directory);
+}
+
+TEST_CASE("Void result exposes the stored error")
+{
+    REQUIRE(check(true).has_value());
+    REQUIRE(check(false).error() == std::errc::invalid_argument);
+}
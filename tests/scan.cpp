@@ -0,0 +1,134 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "scan.hpp"
+
+/// \cond
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::size_t find_reference(std::span<const std::byte> data, std::span<const std::byte> set)
+{
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        for (auto value : set)
+        {
+            if (data[i] == value)
+            {
+                return i;
+            }
+        }
+    }
+
+    return scan::npos;
+}
+
+static std::vector<std::string> split_reference(const std::string& text, char delimiter, std::size_t limit)
+{
+    std::vector<std::string> fields;
+    std::size_t start = 0;
+
+    while (fields.size() + 1 < limit)
+    {
+        auto found = text.find(delimiter, start);
+
+        if (found == std::string::npos)
+        {
+            break;
+        }
+
+        fields.push_back(text.substr(start, found - start));
+        start = found + 1;
+    }
+
+    fields.push_back(text.substr(start));
+    return fields;
+}
+
+static std::string text(scan::field_t field)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return {reinterpret_cast<const char*>(field.data()), field.size()};
+}
+
+// Random text over a small alphabet, so every length hits both the vector
+// loop and the scalar tail with plenty of matches.
+static std::string sample(std::mt19937& random, std::size_t length)
+{
+    static constexpr std::string_view alphabet = "ab,\n;";
+
+    std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+    std::string result(length, ' ');
+
+    for (auto& character : result)
+    {
+        character = alphabet[pick(random)];
+    }
+
+    return result;
+}
+
+TEST_CASE("Scan kernels match the scalar reference")
+{
+    std::mt19937 random(42);  // NOLINT(cert-msc51-cpp)
+
+    for (auto isa : {scan::isa_t::scalar, scan::isa_t::sse2, scan::isa_t::avx2})
+    {
+        if (!scan::force(isa))
+        {
+            continue;
+        }
+
+        for (std::size_t length = 0; length < 130; ++length)
+        {
+            auto input = sample(random, length);
+            auto data = scan::bytes(input);
+
+            auto newline = scan::bytes("\n");
+            auto set = scan::bytes(";\n");
+
+            REQUIRE(scan::find_byte(data, std::byte{'\n'}) == find_reference(data, newline));
+            REQUIRE(scan::find_any(data, set) == find_reference(data, set));
+            REQUIRE(scan::count_newlines(data) == static_cast<std::size_t>(std::count(input.begin(), input.end(), '\n')));
+
+            for (std::size_t limit : {2U, 5U, 200U})
+            {
+                std::vector<scan::field_t> fields(limit);
+                std::vector<std::string> result;
+
+                auto count = scan::split(data, std::byte{','}, fields);
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    result.push_back(text(fields[i]));
+                }
+
+                REQUIRE(result == split_reference(input, ',', limit));
+            }
+        }
+    }
+}
+
+TEST_CASE("Scan handles edge cases")
+{
+    REQUIRE(scan::find_byte({}, std::byte{'x'}) == scan::npos);
+    REQUIRE(scan::find_any(scan::bytes("abc"), {}) == scan::npos);
+
+    std::vector<scan::field_t> fields(1);
+
+    REQUIRE(scan::split(scan::bytes("a,b"), std::byte{','}, fields) == 1);
+    REQUIRE(text(fields[0]) == "a,b");
+    REQUIRE(scan::split(scan::bytes("a,b"), std::byte{','}, {}) == 0);
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "seqlock.hpp"
+#include "thread.hpp"
+
+/// \cond
+#include <atomic>
+#include <cstdint>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    struct quote_t
+    {
+        std::int64_t bid;
+        std::int64_t ask;
+        std::int32_t size;
+    };
+}  // namespace
+
+TEST_CASE("Seqlock readers never see a torn snapshot")
+{
+    seqlock_t<quote_t> quote(quote_t{0, 1, 0});
+    std::atomic<bool> done{false};
+
+    thread_t writer([&] {
+        for (std::int32_t i = 1; i <= 20000; ++i)
+        {
+            quote.store(quote_t{i, i + 1, i});
+        }
+
+        done = true;
+    });
+
+    std::int64_t last = 0;
+
+    while (!done)
+    {
+        auto snapshot = quote.load();
+
+        REQUIRE(snapshot.ask == snapshot.bid + 1);
+        REQUIRE(snapshot.size == snapshot.bid);
+        REQUIRE(snapshot.bid >= last);
+
+        last = snapshot.bid;
+    }
+
+    writer.join();
+    REQUIRE(quote.load().bid == 20000);
+}
+
+TEST_CASE("Seqlock updates in place")
+{
+    seqlock_t<quote_t> quote;
+
+    quote.update([](quote_t& value) { value.size += 5; });
+    quote.update([](quote_t& value) { value.size *= 2; });
+
+    REQUIRE(quote.load().size == 10);
+}
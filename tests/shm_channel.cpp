@@ -0,0 +1,331 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_channel.hpp"
+
+/// \cond
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    std::string channel_name(std::string_view test)
+    {
+        return "toolbox-" + std::string(test) + "-" + std::to_string(::getpid());
+    }
+
+    // Pattern byte at stream position i.
+    std::byte pattern(std::uint64_t i)
+    {
+        return static_cast<std::byte>((i * 7) & 0xFF);
+    }
+
+    // Reaps the child and returns its exit code, or -1 if it did not exit.
+    int reap(pid_t child)
+    {
+        int status = 0;
+
+        if (::waitpid(child, &status, 0) != child || !WIFEXITED(status))
+        {
+            return -1;
+        }
+
+        return WEXITSTATUS(status);
+    }
+
+    // Overwrites the ring capacity stored in the object's header, as a
+    // misbehaving peer could.
+    void corrupt_capacity(const std::string& name, std::uint64_t capacity)
+    {
+        auto fd = ::shm_open(("/" + name).c_str(), O_RDWR, 0);
+        REQUIRE(fd >= 0);
+
+        auto* memory = ::mmap(nullptr, 2 * sizeof(std::uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        REQUIRE(memory != MAP_FAILED);
+
+        // The header starts with the magic, followed by the capacity.
+        std::memcpy(static_cast<std::byte*>(memory) + sizeof(std::uint64_t), &capacity, sizeof(capacity));
+        ::munmap(memory, 2 * sizeof(std::uint64_t));
+    }
+}  // namespace
+
+TEST_CASE("Shared memory channel replaces a stale name")
+{
+    auto name = channel_name("stale");
+
+    // The first owner dies without closing, leaving its name behind.
+    auto child = ::fork();
+    REQUIRE(child >= 0);
+
+    if (child == 0)
+    {
+        auto abandoned = shm_channel_t::create(name, 4096);
+        ::_exit(abandoned ? 0 : 1);
+    }
+
+    REQUIRE(reap(child) == 0);
+    REQUIRE_FALSE(shm_channel_t::create(name, 4096, false));
+
+    auto second = shm_channel_t::create(name, 4096);
+    REQUIRE(second);
+
+    auto peer = shm_channel_t::open(name);
+    REQUIRE(peer);
+
+    auto sent = second->send("ping");
+
+    REQUIRE(sent);
+    REQUIRE(sent.value() == 4);
+
+    std::array<char, 8> buffer{};
+    auto length = peer->recv(buffer.data(), buffer.size());
+
+    REQUIRE(length);
+    REQUIRE(length.value() == 4);
+    REQUIRE(std::string_view(buffer.data(), 4) == "ping");
+}
+
+TEST_CASE("Shared memory channel leaves a live owner's name alone")
+{
+    auto name = channel_name("live");
+
+    auto first = shm_channel_t::create(name, 4096);
+    REQUIRE(first);
+
+    // The owner is this very process, so it is still running.
+    REQUIRE_FALSE(shm_channel_t::create(name, 4096));
+    REQUIRE(shm_channel_t::open(name));
+
+    // Once the name is taken by another object, closing the first owner
+    // must not remove it.
+    REQUIRE(::shm_unlink(("/" + name).c_str()) == 0);
+
+    auto second = shm_channel_t::create(name, 4096);
+    REQUIRE(second);
+
+    first->close();
+    REQUIRE(shm_channel_t::open(name));
+}
+
+TEST_CASE("Shared memory channel only trusts the capacity it validated")
+{
+    auto name = channel_name("capacity");
+
+    auto owner = shm_channel_t::create(name, 4096);
+    REQUIRE(owner);
+
+    auto peer = shm_channel_t::open(name);
+    REQUIRE(peer);
+
+    // Rewriting the header after open does not move either side's rings.
+    corrupt_capacity(name, std::uint64_t{1} << 40);
+
+    auto sent = owner->send("ping");
+    REQUIRE(sent);
+    REQUIRE(sent.value() == 4);
+
+    std::array<char, 8> buffer{};
+    auto length = peer->recv(buffer.data(), buffer.size());
+
+    REQUIRE(length);
+    REQUIRE(length.value() == 4);
+    REQUIRE(std::string_view(buffer.data(), 4) == "ping");
+
+    // A later open sees the bad value and refuses the object.
+    REQUIRE_FALSE(shm_channel_t::open(name));
+
+    corrupt_capacity(name, 3000);
+    REQUIRE_FALSE(shm_channel_t::open(name));
+}
+
+TEST_CASE("Shared memory channel streams between processes")
+{
+    constexpr std::uint64_t total = 1 << 20;
+
+    auto name = channel_name("stream");
+
+    // Far smaller than the stream, so the writer keeps filling the ring and
+    // both sides sleep on the futex in turn.
+    auto channel = shm_channel_t::create(name, 4096);
+    REQUIRE(channel);
+
+    auto child = ::fork();
+    REQUIRE(child >= 0);
+
+    if (child == 0)
+    {
+        auto peer = shm_channel_t::open(name);
+
+        if (!peer)
+        {
+            ::_exit(1);
+        }
+
+        std::array<std::byte, 1000> buffer{};
+        std::uint64_t received = 0;
+
+        while (received < total)
+        {
+            auto length = peer->recv(buffer.data(), buffer.size());
+
+            if (!length || length.value() == 0)
+            {
+                ::_exit(2);
+            }
+
+            for (std::size_t i = 0; i < length.value(); ++i)
+            {
+                if (buffer[i] != pattern(received + i))
+                {
+                    ::_exit(3);
+                }
+            }
+
+            received += length.value();
+
+            // Slow down now and then so the writer has to block.
+            if (received % 65536 < length.value())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        // Acknowledge, then expect the close to end the stream.
+        if (auto sent = peer->send("done"); !sent || sent.value() != 4)
+        {
+            ::_exit(4);
+        }
+
+        if (auto length = peer->recv(buffer.data(), buffer.size()); !length || length.value() != 0)
+        {
+            ::_exit(4);
+        }
+
+        ::_exit(0);
+    }
+
+    std::array<std::byte, 3000> chunk{};
+    std::uint64_t sent = 0;
+
+    while (sent < total)
+    {
+        auto length = static_cast<std::size_t>(std::min<std::uint64_t>(chunk.size(), total - sent));
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            chunk[i] = pattern(sent + i);
+        }
+
+        std::size_t offset = 0;
+
+        while (offset < length)
+        {
+            auto written = channel->send(chunk.data() + offset, length - offset);
+            REQUIRE(written);
+
+            offset += written.value();
+        }
+
+        sent += length;
+    }
+
+    std::array<char, 8> reply{};
+    auto length = channel->recv(reply.data(), reply.size());
+
+    REQUIRE(length);
+    REQUIRE(length.value() == 4);
+    REQUIRE(std::string_view(reply.data(), 4) == "done");
+
+    // The child is blocked in recv() by now, or will find the channel closed.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    channel->close();
+
+    REQUIRE(reap(child) == 0);
+}
+
+TEST_CASE("Shared memory channel wakes a blocked reader")
+{
+    auto name = channel_name("wake");
+
+    auto channel = shm_channel_t::create(name, 4096);
+    REQUIRE(channel);
+
+    auto child = ::fork();
+    REQUIRE(child >= 0);
+
+    if (child == 0)
+    {
+        auto peer = shm_channel_t::open(name);
+
+        if (!peer)
+        {
+            ::_exit(1);
+        }
+
+        // No busy polling: the reader goes straight to the futex.
+        std::array<char, 8> buffer{};
+        auto length = peer->recv(buffer.data(), buffer.size());
+
+        ::_exit(length && length.value() == 5 && std::string_view(buffer.data(), 5) == "hello" ? 0 : 2);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto sent = channel->send("hello");
+
+    REQUIRE(sent);
+    REQUIRE(sent.value() == 5);
+
+    REQUIRE(reap(child) == 0);
+}
+
+TEST_CASE("Shared memory channel reports a closed peer")
+{
+    auto name = channel_name("closed");
+
+    auto channel = shm_channel_t::create(name, 4096);
+    REQUIRE(channel);
+
+    auto peer = shm_channel_t::open(name);
+    REQUIRE(peer);
+
+    auto sent = channel->send("last");
+    REQUIRE(sent);
+
+    channel->close();
+
+    // What was sent before the close is still delivered, then end of stream.
+    std::array<char, 8> buffer{};
+
+    auto length = peer->recv(buffer.data(), buffer.size());
+    REQUIRE(length);
+    REQUIRE(length.value() == 4);
+
+    auto end = peer->recv(buffer.data(), buffer.size());
+    REQUIRE(end);
+    REQUIRE(end.value() == 0);
+
+    auto refused = peer->send("late");
+    REQUIRE_FALSE(refused);
+    REQUIRE(refused.error() == std::errc::broken_pipe);
+}
@@ -0,0 +1,332 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "socket.hpp"
+
+/// \cond
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+namespace
+{
+    // Both ends of a connected Unix stream socket.
+    std::pair<socket_t, socket_t> connected_pair()
+    {
+        auto path = "/tmp/toolbox-socket-" + std::to_string(::getpid()) + ".sock";
+        ::unlink(path.c_str());
+
+        auto endpoint = endpoint_t::local(path);
+        REQUIRE(endpoint);
+
+        socket_t listener(AF_UNIX);
+        REQUIRE(listener.bind(*endpoint));
+        REQUIRE(listener.listen());
+
+        socket_t client(AF_UNIX);
+        REQUIRE(client.connect(*endpoint));
+
+        auto server = listener.accept();
+        REQUIRE(server);
+
+        ::unlink(path.c_str());
+        return {std::move(client), std::move(server.value())};
+    }
+}  // namespace
+
+TEST_CASE("Socket spins for data that arrives within the budget")
+{
+    auto [client, server] = connected_pair();
+    server.set_spin(std::chrono::seconds(5));
+
+    std::optional<std::size_t> sent;
+
+    std::thread writer([&client, &sent] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (auto result = client.send("spin"))
+        {
+            sent = result.value();
+        }
+    });
+
+    std::array<char, 8> buffer{};
+    auto length = server.recv(buffer.data(), buffer.size());
+
+    writer.join();
+
+    REQUIRE(sent == 4);
+    REQUIRE(length);
+    REQUIRE(length.value() == 4);
+    REQUIRE(std::string_view(buffer.data(), 4) == "spin");
+}
+
+TEST_CASE("Socket blocks once the spin budget is spent")
+{
+    auto [client, server] = connected_pair();
+    server.set_spin(std::chrono::microseconds(100));
+
+    std::optional<std::size_t> sent;
+
+    std::thread writer([&client, &sent] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if (auto result = client.send("late"))
+        {
+            sent = result.value();
+        }
+    });
+
+    std::array<char, 8> buffer{};
+    auto length = server.recv(buffer.data(), buffer.size());
+
+    writer.join();
+
+    REQUIRE(sent == 4);
+    REQUIRE(length);
+    REQUIRE(length.value() == 4);
+    REQUIRE(std::string_view(buffer.data(), 4) == "late");
+
+    // End of stream ends the spin as well.
+    server.set_spin(std::chrono::seconds(5));
+    client.close();
+
+    auto end = server.recv(buffer.data(), buffer.size());
+
+    REQUIRE(end);
+    REQUIRE(end.value() == 0);
+}
+
+TEST_CASE("Socket busy polling is set or refused cleanly")
+{
+    socket_t socket;
+
+    // Raising the budget above net.core.busy_read needs CAP_NET_ADMIN on
+    // recent kernels; anything else is a bug.
+    auto status = socket.set_busy_poll(std::chrono::microseconds(50));
+
+    if (!status)
+    {
+        REQUIRE((status.error() == std::errc::operation_not_permitted || status.error() == std::errc::not_supported));
+    }
+
+    REQUIRE(socket.set_busy_poll(std::chrono::microseconds(0)));
+}
+
+TEST_CASE("Socket reports the peer address it accepted")
+{
+    socket_t listener;
+
+    REQUIRE(listener.bind(*endpoint_t::parse("127.0.0.1", 0)));
+    REQUIRE(listener.listen());
+
+    auto endpoint = listener.local_endpoint();
+    REQUIRE(endpoint);
+
+    socket_t client;
+    REQUIRE(client.connect(endpoint.value()));
+
+    endpoint_t peer;
+    auto server = listener.accept(peer);
+
+    REQUIRE(server);
+    REQUIRE(peer.family() == AF_INET);
+    REQUIRE(peer.to_string().starts_with("127.0.0.1"));
+}
+
+TEST_CASE("Socket accepts IPv4 clients on a dual-stack listener")
+{
+    socket_t listener;
+
+    if (!listener.bind(*endpoint_t::parse("::", 0), true))
+    {
+        SKIP("IPv6 is unavailable");
+    }
+
+    REQUIRE(listener.listen());
+
+    auto endpoint = listener.local_endpoint();
+    REQUIRE(endpoint);
+
+    socket_t client;
+    REQUIRE(client.connect(*endpoint_t::parse("127.0.0.1", endpoint.value().port())));
+
+    // The IPv4 client shows up as a mapped IPv6 address.
+    endpoint_t peer;
+    auto server = listener.accept(peer);
+
+    REQUIRE(server);
+    REQUIRE(peer.family() == AF_INET6);
+    REQUIRE(peer.to_string().starts_with("[::ffff:127.0.0.1]"));
+
+    // Without dual stack the same kind of listener is out of IPv4's reach.
+    socket_t only;
+    REQUIRE(only.bind(*endpoint_t::parse("::", 0), false));
+    REQUIRE(only.listen());
+
+    auto port = only.local_endpoint();
+    REQUIRE(port);
+
+    socket_t refused;
+    REQUIRE_FALSE(refused.connect(*endpoint_t::parse("127.0.0.1", port.value().port())));
+}
+
+TEST_CASE("Socket calls carry the error code")
+{
+    SECTION("accept on a socket that is not listening")
+    {
+        socket_t socket;
+        auto accepted = socket.accept();
+
+        REQUIRE_FALSE(accepted);
+        REQUIRE(accepted.error() == std::errc::invalid_argument);
+    }
+
+    SECTION("recv and send on a socket that is not connected")
+    {
+        socket_t socket;
+        std::array<char, 8> buffer{};
+
+        auto received = socket.recv(buffer.data(), buffer.size());
+
+        REQUIRE_FALSE(received);
+        REQUIRE(received.error() == std::errc::not_connected);
+
+        // No SIGPIPE: the failure comes back as a code.
+        auto sent = socket.send("lost");
+
+        REQUIRE_FALSE(sent);
+        REQUIRE(sent.error() == std::errc::broken_pipe);
+    }
+
+    SECTION("send after the peer closed")
+    {
+        auto [client, server] = connected_pair();
+        server.close();
+
+        auto sent = client.send("lost");
+
+        REQUIRE_FALSE(sent);
+        REQUIRE(sent.error() == std::errc::broken_pipe);
+    }
+
+    SECTION("recv from a chain on a socket that is not connected")
+    {
+        socket_t socket;
+        buffer_chain_t chain;
+
+        auto received = socket.recv(chain);
+
+        REQUIRE_FALSE(received);
+        REQUIRE(received.error() == std::errc::not_connected);
+        REQUIRE(chain.size() == 0);
+    }
+}
+
+TEST_CASE("Socket streams a file range")
+{
+    auto path = "/tmp/toolbox-socket-file-" + std::to_string(::getpid());
+
+    std::string content(200 * 1024, '\0');
+
+    for (std::size_t i = 0; i < content.size(); ++i)
+    {
+        content[i] = static_cast<char>('a' + i % 26);
+    }
+
+    auto file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    REQUIRE(file != -1);
+    REQUIRE(::write(file, content.data(), content.size()) == static_cast<ssize_t>(content.size()));
+
+    ::unlink(path.c_str());
+
+    auto [client, server] = connected_pair();
+
+    // More than the socket buffer holds, so the reader has to keep up.
+    std::string received;
+
+    std::thread reader([&server, &received] {
+        std::array<char, 4096> buffer{};
+
+        while (auto length = server.recv(buffer.data(), buffer.size()))
+        {
+            if (length.value() == 0)
+            {
+                break;
+            }
+
+            received.append(buffer.data(), length.value());
+        }
+    });
+
+    // Asks for more than the file holds: the count stops at its end.
+    auto sent = client.send_file(file, 100, content.size());
+    client.close();
+    reader.join();
+
+    REQUIRE(sent);
+    REQUIRE(sent.value() == content.size() - 100);
+    REQUIRE(received == content.substr(100));
+
+    auto failed = client.send_file(file, 0, 10);
+
+    REQUIRE_FALSE(failed);
+    REQUIRE(failed.error().transferred == 0);
+    REQUIRE(failed.error().code == std::errc::bad_file_descriptor);
+
+    ::close(file);
+}
+
+TEST_CASE("Socket splices one connection into another")
+{
+    auto [source, inbound] = connected_pair();
+    auto [outbound, sink] = connected_pair();
+
+    auto sent = source.send("forwarded");
+    REQUIRE(sent);
+
+    auto spliced = inbound.splice_to(outbound, 1024);
+
+    REQUIRE(spliced);
+    REQUIRE(spliced.value() == 9);
+
+    std::array<char, 16> buffer{};
+    auto length = sink.recv(buffer.data(), buffer.size());
+
+    REQUIRE(length);
+    REQUIRE(std::string_view(buffer.data(), length.value()) == "forwarded");
+
+    // The source has closed: nothing is forwarded, and that is not an error.
+    source.close();
+
+    auto drained = inbound.splice_to(outbound, 1024);
+
+    REQUIRE(drained);
+    REQUIRE(drained.value() == 0);
+
+    // A target that is gone fails with the error, not a short count.
+    auto [second_source, second_inbound] = connected_pair();
+    REQUIRE(second_source.send("lost"));
+
+    outbound.close();
+
+    auto failed = second_inbound.splice_to(outbound, 1024);
+
+    REQUIRE_FALSE(failed);
+    REQUIRE(failed.error().transferred == 0);
+    REQUIRE(failed.error().code == std::errc::bad_file_descriptor);
+}
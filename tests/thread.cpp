@@ -0,0 +1,132 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "reactor.hpp"
+#include "thread.hpp"
+
+/// \cond
+#include <atomic>
+#include <chrono>
+#include <stop_token>
+#include <thread>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Thread passes a stop token to callables that take one")
+{
+    std::atomic<bool> stopped{false};
+
+    auto worker = [&stopped](std::stop_token token, int step) {
+        while (!token.stop_requested())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(step));
+        }
+
+        stopped = true;
+    };
+
+    {
+        thread_t thread(worker, 1);
+
+        REQUIRE(thread.joinable());
+        REQUIRE_FALSE(thread.get_stop_token().stop_requested());
+    }
+
+    // The destructor requested the stop before joining.
+    REQUIRE(stopped);
+}
+
+TEST_CASE("Thread runs callables without a stop token")
+{
+    int value = 0;
+
+    thread_t thread([&value](int increment) { value += increment; }, 42);
+    thread.join();
+
+    REQUIRE(value == 42);
+    REQUIRE_FALSE(thread.joinable());
+}
+
+TEST_CASE("Thread join is bounded by join_for")
+{
+    std::atomic<bool> release{false};
+
+    thread_t thread([&release] {
+        while (!release)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // Ignores the stop token, so only the timeout ends the wait.
+    REQUIRE(thread.request_stop());
+    REQUIRE_FALSE(thread.join_for(std::chrono::milliseconds(20)));
+    REQUIRE(thread.joinable());
+
+    release = true;
+
+    REQUIRE(thread.join_for(std::chrono::seconds(5)));
+    REQUIRE_FALSE(thread.joinable());
+    REQUIRE_FALSE(thread.join_for(std::chrono::milliseconds(0)));
+}
+
+TEST_CASE("Thread stop wakes a reactor blocked in poll")
+{
+    reactor_t reactor;
+
+    thread_t thread([&reactor](std::stop_token token) { reactor.run(std::move(token)); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    REQUIRE(thread.request_stop());
+    REQUIRE_FALSE(thread.request_stop());
+    REQUIRE(thread.join_for(std::chrono::seconds(5)));
+}
+
+TEST_CASE("Thread parses kernel cpu lists")
+{
+    REQUIRE(thread_t::listed("0,2-5,8", 0));
+    REQUIRE(thread_t::listed("0,2-5,8", 4));
+    REQUIRE(thread_t::listed("0,2-5,8", 8));
+    REQUIRE_FALSE(thread_t::listed("0,2-5,8", 1));
+    REQUIRE_FALSE(thread_t::listed("0,2-5,8", 6));
+    REQUIRE_FALSE(thread_t::listed("", 0));
+    REQUIRE_FALSE(thread_t::isolation(-1).any());
+}
+
+TEST_CASE("Thread applies scheduling settings")
+{
+    thread_t thread([](std::stop_token token) {
+        while (!token.stop_requested())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // Raising the nice value never needs privileges.
+    auto result = thread.configure({.policy = thread_t::policy_t::batch, .nice = 5});
+    REQUIRE(result);
+
+    REQUIRE(thread.set_scheduling(thread_t::policy_t::idle));
+
+    // Leaving SCHED_IDLE needs CAP_SYS_NICE or a matching RLIMIT_NICE, so
+    // an unprivileged run may be refused.
+    auto normal = thread.set_scheduling(thread_t::policy_t::normal);
+
+    if (!normal)
+    {
+        REQUIRE(normal.error() == std::errc::operation_not_permitted);
+    }
+
+    auto invalid = thread.set_scheduling(thread_t::policy_t::fifo, 0);
+    REQUIRE_FALSE(invalid);
+    REQUIRE(invalid.error() == std::errc::invalid_argument);
+
+    auto idle = thread_t();
+    REQUIRE(idle.set_nice(1).error() == std::errc::no_such_process);
+}